@@ -0,0 +1,152 @@
+#include <cstddef>
+#include <cstdlib>
+#include <span>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include <SDL3/SDL_log.h>
+#include <SDL3/SDL_stdinc.h>
+#include <SDL3/SDL_timer.h>
+#include <glaze/core/common.hpp>
+#include <glaze/json/write.hpp>
+
+#include "vts/request.hpp"
+
+// Times the two ways an InjectParameterDataRequest has been written: the
+// whole request through glaze, as it was before InjectionEncoder, and the
+// encoder's pre-split envelope. Both reuse one buffer and render the same
+// values with a fresh request id per message, so the difference is the
+// serialization alone.
+
+static constexpr int         DEFAULT_PRECISION  = 6;
+static constexpr std::size_t DEFAULT_PARAMETERS = 32;
+static constexpr Uint64      DEFAULT_ITERATIONS = 200000;
+
+struct GlazeInjectionData {
+	bool                                 faceFound = false;
+	std::string_view                     mode      = "set";
+	std::span<const vts::ParameterValue> parameterValues;
+
+	struct glaze {
+		using T                     = GlazeInjectionData;
+		static constexpr auto value = glz::object("faceFound",
+		                                          &T::faceFound,
+		                                          "mode",
+		                                          &T::mode,
+		                                          "parameterValues",
+		                                          &T::parameterValues);
+	};
+};
+
+struct GlazeInjection {
+	std::string_view   apiName     = "VTubeStudioPublicAPI";
+	std::string_view   apiVersion  = "1.0";
+	std::string        requestId   = {};
+	std::string_view   messageType = "InjectParameterDataRequest";
+	GlazeInjectionData data;
+
+	struct glaze {
+		using T                     = GlazeInjection;
+		static constexpr auto value = glz::object("apiName",
+		                                          &T::apiName,
+		                                          "apiVersion",
+		                                          &T::apiVersion,
+		                                          "requestID",
+		                                          &T::requestId,
+		                                          "messageType",
+		                                          &T::messageType,
+		                                          "data",
+		                                          &T::data);
+	};
+};
+
+struct Result {
+	double      nsPerMessage;
+	std::size_t bytes;
+};
+
+// Values drift a little every message so no run can settle on a cached
+// rendering of the same numbers.
+static void nudge(std::vector<vts::ParameterValue>& values, const Uint64 n) {
+	values[n % values.size()].value += 1e-6F;
+}
+
+static Result timeGlaze(std::vector<vts::ParameterValue> values,
+                        const Uint64                     iterations) {
+	GlazeInjection request;
+	std::string    buffer;
+	std::size_t    bytes   = 0;
+	const Uint64   startNs = SDL_GetTicksNS();
+	for (Uint64 n = 1; n <= iterations; ++n) {
+		request.requestId            = std::to_string(n);
+		request.data.parameterValues = values;
+		buffer.clear();
+		if (glz::write_json(request, buffer)) {
+			SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "Failed to serialize");
+			return {.nsPerMessage = 0.0, .bytes = 0};
+		}
+		bytes += buffer.size();
+		nudge(values, n);
+	}
+	const Uint64 elapsedNs = SDL_GetTicksNS() - startNs;
+	return {.nsPerMessage = static_cast<double>(elapsedNs)
+	                        / static_cast<double>(iterations),
+	        .bytes        = bytes / iterations};
+}
+
+static Result timeEncoder(std::vector<vts::ParameterValue> values,
+                          const int                        precision,
+                          const Uint64                     iterations) {
+	const vts::InjectionEncoder encoder(precision);
+	std::string                 buffer;
+	std::size_t                 bytes   = 0;
+	const Uint64                startNs = SDL_GetTicksNS();
+	for (Uint64 n = 1; n <= iterations; ++n) {
+		encoder.encode(n, values, buffer);
+		bytes += buffer.size();
+		nudge(values, n);
+	}
+	const Uint64 elapsedNs = SDL_GetTicksNS() - startNs;
+	return {.nsPerMessage = static_cast<double>(elapsedNs)
+	                        / static_cast<double>(iterations),
+	        .bytes        = bytes / iterations};
+}
+
+int main(int argc, char* argv[]) {
+	const std::size_t nParameters =
+	    argc > 1 ? std::strtoul(argv[1], nullptr, 10) : DEFAULT_PARAMETERS;
+	const int    precision  = argc > 2 ? std::atoi(argv[2]) : DEFAULT_PRECISION;
+	const Uint64 iterations = argc > 3 ? std::strtoull(argv[3], nullptr, 10)
+	                                   : DEFAULT_ITERATIONS;
+	if (nParameters == 0 || iterations == 0) {
+		SDL_Log("Usage: %s [parameters] [precision] [iterations]", argv[0]);
+		return 1;
+	}
+
+	std::vector<std::string> names;
+	names.reserve(nParameters);
+	for (std::size_t i = 0; i < nParameters; ++i) {
+		names.push_back("MK_Parameter" + std::to_string(i));
+	}
+	std::vector<vts::ParameterValue> values;
+	values.reserve(nParameters);
+	for (std::size_t i = 0; i < nParameters; ++i) {
+		values.push_back(
+		    {.id = names[i], .value = static_cast<float>(i) * 0.0371F});
+	}
+
+	const Result glaze   = timeGlaze(values, iterations);
+	const Result encoder = timeEncoder(values, precision, iterations);
+	SDL_Log("%zu parameters, precision %d, %llu messages",
+	        nParameters,
+	        precision,
+	        static_cast<unsigned long long>(iterations));
+	SDL_Log("glaze:   %8.1f ns/message, %zu bytes",
+	        glaze.nsPerMessage,
+	        glaze.bytes);
+	SDL_Log("encoder: %8.1f ns/message, %zu bytes",
+	        encoder.nsPerMessage,
+	        encoder.bytes);
+	return 0;
+}
@@ -1,6 +1,11 @@
 #ifndef CORE_APP_HPP_
 #define CORE_APP_HPP_
 
+#include <cstddef>
+#include <memory>
+#include <string>
+#include <vector>
+
 #include <SDL3/SDL_events.h>
 #include <SDL3/SDL_gpu.h>
 #include <SDL3/SDL_tray.h>
@@ -11,7 +16,14 @@
 #include "impulse/processor.hpp"
 #include "mnk/monitor.hpp"
 #include "pad/manager.hpp"
+#include "vts/item_manager.hpp"
+#include "vts/mirror.hpp"
+#include "vts/model_cache.hpp"
+#include "vts/parameter_batch.hpp"
 #include "vts/parameter_manager.hpp"
+#include "vts/refresh_debouncer.hpp"
+#include "vts/request.hpp"
+#include "vts/session.hpp"
 #include "ws/client.hpp"
 
 namespace core {
@@ -19,30 +31,53 @@ namespace core {
 class App {
 private:
 	bool           _alive;
+	bool           _isModelLoaded;
+	bool           _isPollingModel;
+	Uint64         _nextModelPollNs;
 	Pacer          _pacer;
 	SDL_GPUDevice* _gpu;
 
-	vts::ParameterManager _parameters;
-	imp::Processor        _impulseProcessor;
+	vts::ParameterManager            _parameters;
+	imp::Processor                   _impulseProcessor;
+	vts::InjectionEncoder            _injectionEncoder;
+	std::vector<vts::ParameterValue> _payload;
+	vts::RefreshDebouncer            _listRefresh;
+	vts::ModelCache                  _models;
+	vts::ItemManager                 _items;
+	Uint64                           _itemMoveId;
 
 	ws::Client   _wsClient;
+	vts::Session _session;
 	mnk::Monitor _mnkMonitor;
 	pad::Manager _gamepadManager;
 
+	std::vector<std::unique_ptr<vts::Mirror>> _mirrors;
+	std::vector<vts::ParameterValue>          _mirrorPayload;
+	std::vector<ws::IController*>             _recipients;
+
 	gui::ConfigWindow _config;
 	gui::TrayIcon     _icon;
 
 	void handleThemeHueChange(const SDL_UserEvent& event);
 	void handleVtsApiError();
-	void handleVtsAuthenticationFailure();
-	void handleVtsAuthenticationSuccess();
-	void handleVtsAuthenticationToken(SDL_UserEvent& event);
 	void handleVtsInputParameterList(SDL_UserEvent& event);
-	void handleVtsParameterCreation();
+	void handleVtsItemEvent(SDL_UserEvent& event);
+	void handleVtsModelLoaded(SDL_UserEvent& event);
+	void handleVtsParameterCreation(SDL_UserEvent& event);
 	void handleVtsParameterDeletion();
 
-	void checkParameterValues();
-	void loadParameterSettings();
+	void      applyParameterNames(const std::vector<std::string>& names);
+	void      checkItemMoves();
+	void      checkModelPoll();
+	void      checkParameterValues();
+	void      loadItemSettings();
+	void      loadParameterSettings(const std::vector<std::string>& names);
+	void      pruneParameterSettings();
+	void      refreshParameterList();
+	vts::Task applyParameterBatch(std::unique_ptr<vts::ParameterBatch> batch);
+	vts::Task startSession();
+
+	vts::Mirror* findMirror(std::size_t instance);
 
 public:
 	App();
@@ -0,0 +1,43 @@
+#ifndef CORE_BITSET_HPP_
+#define CORE_BITSET_HPP_
+
+#include <bit>
+#include <cstddef>
+#include <vector>
+
+#include <SDL3/SDL_stdinc.h>
+
+namespace core {
+
+class DynamicBitset {
+private:
+	static constexpr std::size_t WORD_BITS = 64;
+
+	std::vector<Uint64> _words;
+
+public:
+	DynamicBitset();
+
+	[[nodiscard]] bool any() const;
+	[[nodiscard]] bool test(std::size_t index) const;
+
+	void clear();
+	void reset(std::size_t index);
+	void resize(std::size_t size);
+	void set(std::size_t index);
+
+	template <typename Fn>
+	void drain(Fn&& fn) {
+		for (std::size_t w = 0; w < _words.size(); ++w) {
+			while (_words[w] != 0) {
+				const auto bit = std::countr_zero(_words[w]);
+				_words[w] &= _words[w] - 1;
+				fn(w * WORD_BITS + bit);
+			}
+		}
+	}
+};
+
+}  // namespace core
+
+#endif  // CORE_BITSET_HPP_
@@ -0,0 +1,101 @@
+#ifndef CORE_BOUNDED_QUEUE_HPP_
+#define CORE_BOUNDED_QUEUE_HPP_
+
+#include <array>
+#include <atomic>
+#include <bit>
+#include <cstddef>
+#include <utility>
+
+namespace core {
+
+// Fixed-capacity lock-free queue after Dmitry Vyukov's bounded MPMC design.
+// Each slot carries a sequence number that tells a pusher or popper whether
+// the slot is ready for it, so neither side ever waits on the other: a push
+// into a full queue or a pop from an empty one fails immediately.
+template <typename T, std::size_t Capacity>
+class BoundedQueue {
+private:
+	static_assert(std::has_single_bit(Capacity),
+	              "capacity must be a power of two");
+
+	static constexpr std::size_t MASK       = Capacity - 1;
+	static constexpr std::size_t CACHE_LINE = 64;
+
+	struct Slot {
+		std::atomic<std::size_t> sequence;
+		T                        value;
+	};
+
+	alignas(CACHE_LINE) std::array<Slot, Capacity> _slots;
+	alignas(CACHE_LINE) std::atomic<std::size_t> _pushPosition;
+	alignas(CACHE_LINE) std::atomic<std::size_t> _popPosition;
+
+	// Claims the next slot whose sequence is `position + offset`, or returns
+	// nullptr once the queue is full (pushing) or empty (popping).
+	Slot* claim(std::atomic<std::size_t>& cursor,
+	            const std::size_t         offset,
+	            std::size_t&              position) {
+		position = cursor.load(std::memory_order_relaxed);
+		for (;;) {
+			Slot&             slot     = _slots[position & MASK];
+			const std::size_t sequence = slot.sequence.load(std::memory_order_acquire);
+			const auto        lag      =
+			    static_cast<std::ptrdiff_t>(sequence - position - offset);
+			if (lag == 0) {
+				if (cursor.compare_exchange_weak(position,
+				                                 position + 1,
+				                                 std::memory_order_relaxed)) {
+					return &slot;
+				}
+			}
+			else if (lag < 0) {
+				return nullptr;
+			}
+			else {
+				position = cursor.load(std::memory_order_relaxed);
+			}
+		}
+	}
+
+public:
+	BoundedQueue() :
+	    _slots(),
+	    _pushPosition(0),
+	    _popPosition(0) {
+		for (std::size_t i = 0; i < Capacity; ++i) {
+			_slots[i].sequence.store(i, std::memory_order_relaxed);
+		}
+	}
+
+	BoundedQueue(BoundedQueue&)            = delete;
+	BoundedQueue& operator=(BoundedQueue&) = delete;
+
+	// Leaves `value` untouched when the queue is full.
+	bool tryPush(T&& value) {
+		std::size_t position = 0;
+		Slot*       slot     = claim(_pushPosition, 0, position);
+		if (slot == nullptr) {
+			return false;
+		}
+		slot->value = std::move(value);
+		slot->sequence.store(position + 1, std::memory_order_release);
+		return true;
+	}
+
+	bool tryPop(T& value) {
+		std::size_t position = 0;
+		Slot*       slot     = claim(_popPosition, 1, position);
+		if (slot == nullptr) {
+			return false;
+		}
+		value       = std::move(slot->value);
+		slot->value = T();
+		slot->sequence.store(position + Capacity, std::memory_order_release);
+		return true;
+	}
+};
+
+}  // namespace core
+
+#endif  // CORE_BOUNDED_QUEUE_HPP_
@@ -1,7 +1,10 @@
 #ifndef CORE_SETTINGS_HPP_
 #define CORE_SETTINGS_HPP_
 
+#include <cstddef>
 #include <mutex>
+#include <optional>
+#include <span>
 #include <string>
 #include <vector>
 
@@ -9,6 +12,7 @@
 #include <glaze/core/meta.hpp>
 
 #include "impulse/code.hpp"
+#include "impulse/generator.hpp"
 #include "math/geometry.hpp"
 #include "vts/parameter.hpp"
 
@@ -18,6 +22,25 @@ struct glz::meta<vts::BlendMode> {
 	static constexpr auto value = glz::enumerate(MAX, BOUNDED_SUM);
 };
 
+template <>
+struct glz::meta<imp::Waveform> {
+	using enum imp::Waveform;
+	static constexpr auto value = glz::enumerate(SINE, TRIANGLE, NOISE, BLINK);
+};
+
+template <>
+struct glz::meta<imp::GeneratorConfig> {
+	using T                     = imp::GeneratorConfig;
+	static constexpr auto value = object("id",
+	                                     &T::id,
+	                                     "waveform",
+	                                     &T::waveform,
+	                                     "rate",
+	                                     &T::rate,
+	                                     "phase",
+	                                     &T::phase);
+};
+
 template <typename T>
 struct glz::meta<math::Rectangle<T>> {
 	using Type                  = math::Rectangle<T>;
@@ -45,10 +68,28 @@ struct SettingsReceiver {
 	};
 };
 
+struct SettingsLink {
+	std::string source;
+	float       weight;
+
+	struct glaze {
+		using T = SettingsLink;
+
+		static constexpr auto value =
+		    glz::object("source", &T::source, "weight", &T::weight);
+	};
+};
+
 struct SettingsParameter {
 	std::string                   name;
 	vts::BlendMode                blendMode;
 	std::vector<SettingsReceiver> receivers;
+	float                         epsilon         = 0.0F;
+	int                           quantization    = 0;
+	std::string                   expression      = "";
+	std::vector<SettingsLink>     links;
+	float                         springFrequency = 0.0F;
+	float                         springDamping   = 0.5F;
 
 	struct glaze {
 		using T = SettingsParameter;
@@ -58,22 +99,102 @@ struct SettingsParameter {
 		                                          "blend_mode",
 		                                          &T::blendMode,
 		                                          "inputs",
-		                                          &T::receivers);
+		                                          &T::receivers,
+		                                          "epsilon",
+		                                          &T::epsilon,
+		                                          "quantization",
+		                                          &T::quantization,
+		                                          "expression",
+		                                          &T::expression,
+		                                          "links",
+		                                          &T::links,
+		                                          "spring_frequency",
+		                                          &T::springFrequency,
+		                                          "spring_damping",
+		                                          &T::springDamping);
+	};
+};
+
+struct SettingsItemChannel {
+	std::vector<SettingsReceiver> receivers;
+	vts::BlendMode                blendMode    = vts::BlendMode::MAX;
+	float                         epsilon      = 0.0F;
+	int                           quantization = 0;
+	float                         low          = 0.0F;
+	float                         high         = 1.0F;
+
+	struct glaze {
+		using T = SettingsItemChannel;
+
+		static constexpr auto value = glz::object("inputs",
+		                                          &T::receivers,
+		                                          "blend_mode",
+		                                          &T::blendMode,
+		                                          "epsilon",
+		                                          &T::epsilon,
+		                                          "quantization",
+		                                          &T::quantization,
+		                                          "low",
+		                                          &T::low,
+		                                          "high",
+		                                          &T::high);
+	};
+};
+
+// A VTS item moved by impulses. Channels that are left out are not driven.
+struct SettingsItem {
+	std::string                        fileName;
+	std::optional<SettingsItemChannel> positionX;
+	std::optional<SettingsItemChannel> positionY;
+	std::optional<SettingsItemChannel> rotation;
+	std::optional<SettingsItemChannel> size;
+
+	struct glaze {
+		using T = SettingsItem;
+
+		static constexpr auto value = glz::object("file_name",
+		                                          &T::fileName,
+		                                          "position_x",
+		                                          &T::positionX,
+		                                          "position_y",
+		                                          &T::positionY,
+		                                          "rotation",
+		                                          &T::rotation,
+		                                          "size",
+		                                          &T::size);
+	};
+};
+
+// Another VTS instance, e.g. a backup on a second machine, that is fed the
+// same values as the one at apiUrl.
+struct SettingsMirror {
+	std::string url;
+	std::string vtsToken = "";
+
+	struct glaze {
+		using T = SettingsMirror;
+
+		static constexpr auto value =
+		    glz::object("url", &T::url, "vts_token", &T::vtsToken);
 	};
 };
 
 struct Settings {
-	std::string          apiUrl           = "localhost:8001";
-	std::string          vtsToken         = "";
-	float                themeHueShift    = 0.0F;
-	int                  mouseSensitivity = 20;
+	std::string          apiUrl             = "localhost:8001";
+	std::string          vtsToken           = "";
+	float                themeHueShift      = 0.0F;
+	int                  mouseSensitivity   = 20;
+	int                  injectionPrecision = 6;
 	math::Rectangle<int> mouseBounds{
 	    .top    = 0,
 	    .left   = 0,
 	    .bottom = 127,
 	    .right  = 127,
 	};
-	std::vector<SettingsParameter> parameters;
+	std::vector<SettingsParameter>    parameters;
+	std::vector<imp::GeneratorConfig> generators;
+	std::vector<SettingsMirror>       mirrors;
+	std::vector<SettingsItem>         items;
 
 	struct glaze {
 		using T = Settings;
@@ -89,7 +210,15 @@ struct Settings {
 		                                          "mouse_bounds",
 		                                          &T::mouseBounds,
 		                                          "parameters",
-		                                          &T::parameters);
+		                                          &T::parameters,
+		                                          "generators",
+		                                          &T::generators,
+		                                          "injection_precision",
+		                                          &T::injectionPrecision,
+		                                          "mirrors",
+		                                          &T::mirrors,
+		                                          "items",
+		                                          &T::items);
 	};
 };
 
@@ -104,6 +233,7 @@ private:
 	void loadDefault();
 	void save();
 	void saveUnlocked();
+	void storeParameterUnlocked(const vts::Parameter& parameter);
 
 public:
 	static SettingsManager& instance();
@@ -114,21 +244,28 @@ public:
 	SettingsManager(SettingsManager&&)                 = delete;
 	SettingsManager& operator=(SettingsManager&&)      = delete;
 
-	const math::Rectangle<int>           getMouseBounds() const;
-	const std::string                    getAuthToken() const;
-	const std::string                    getWsUrl() const;
-	const std::vector<SettingsParameter> getParameters() const;
-	float                                getThemeHueShift() const;
-	int                                  getMouseSensitivity() const;
+	const math::Rectangle<int>              getMouseBounds() const;
+	const std::string                       getAuthToken(std::size_t index) const;
+	const std::string                       getWsUrl(std::size_t index) const;
+	const std::vector<SettingsParameter>    getParameters() const;
+	const std::vector<imp::GeneratorConfig> getGenerators() const;
+	const std::vector<SettingsItem>         getItems() const;
+	float                                   getThemeHueShift() const;
+	int                                     getInjectionPrecision() const;
+	int                                     getMouseSensitivity() const;
+	std::size_t                             getInstanceCount() const;
 
-	void setAuthToken(const char* newAuthToken);
+	void setAuthToken(std::size_t index, const char* newAuthToken);
+	void setGenerators(const std::vector<imp::GeneratorConfig>& generators);
 	void setMouseBounds(const math::Rectangle<int>& bounds);
 	void setMouseSensitivity(int newSensitivity);
 	void setParameter(const vts::Parameter& parameter);
+	void setParameters(std::span<const vts::Parameter> parameters);
 	void setThemeHueShift(float shift);
-	void setWsUrl(const char* newWsUrl);
+	void setWsUrl(std::size_t index, const char* newWsUrl);
 
 	void removeParameter(const std::string& name);
+	void removeParameters(std::span<const std::string> names);
 };
 
 };  // namespace core
@@ -2,6 +2,9 @@
 #define GUI_ADD_IMPULSE_MODAL_HPP_
 
 #include <string>
+#include <vector>
+
+#include <SDL3/SDL_stdinc.h>
 
 #include "imgui/imgui.h"
 
@@ -31,6 +34,13 @@ private:
 	ComboBox _gamepadStickActionSelector;
 	ComboBox _gamepadTriggerSelector;
 
+	std::vector<Uint16>      _generatorIds;
+	std::vector<std::string> _generatorNames;
+	std::vector<const char*> _generatorOptions;
+	ComboBox                 _generatorSelector;
+
+	int _clipChannel;
+
 	[[nodiscard]] imp::TargetTag getMouseAxisTag() const;
 	[[nodiscard]] imp::TargetTag getMouseButtonTag() const;
 	[[nodiscard]] imp::TargetTag getMouseWheelTag() const;
@@ -58,6 +68,11 @@ private:
 	void showGamepadStickActionSelector();
 	void showGamepadTriggerSelector();
 
+	void refreshGenerators();
+	void showGeneratorControls();
+
+	void showClipControls();
+
 public:
 	explicit AddImpulseModal(vts::Parameter& editingParameter);
 	void show();
@@ -2,11 +2,13 @@
 #define GUI_CONFIG_SETTINGS_PANEL_HPP_
 
 #include <cstddef>
+#include <vector>
 
 #include <SDL3/SDL_stdinc.h>
 
 #include "gui/combo_box.hpp"
 #include "gui/set_mouse_bounds_modal.hpp"
+#include "impulse/generator.hpp"
 #include "impulse/processor.hpp"
 #include "pad/manager.hpp"
 #include "vts/parameter.hpp"
@@ -23,11 +25,15 @@ private:
 
 	SetMouseBoundsModal _setMouseBoundsModal;
 
-	char     _urlBuffer[MAX_URL_LENGTH];
-	ComboBox _gamepadSelector;
-	int      _mouseSensitivity;
+	char                              _urlBuffer[MAX_URL_LENGTH];
+	ComboBox                          _gamepadSelector;
+	int                               _mouseSensitivity;
+	std::vector<imp::GeneratorConfig> _generators;
 
+	void showClipSettings();
 	void showGamepadSettings();
+	void showGeneratorSettings();
+	void showLatencySettings();
 	void showMouseMotionSettings();
 	void showMousePositionSettings();
 	void showSettingsPanel();
@@ -12,44 +12,59 @@
 #include "gui/combo_box.hpp"
 #include "impulse/code.hpp"
 #include "vts/parameter.hpp"
+#include "vts/parameter_manager.hpp"
 #include "ws/controller.hpp"
 
 constexpr size_t MAX_NAME_BUFFER_LENGTH =
     core::MAX_PARAMETER_LENGTH + sizeof('\0');
-constexpr size_t N_HISTORY_SAMPLES = 128;
+constexpr size_t MAX_EXPRESSION_BUFFER_LENGTH = 256;
+constexpr size_t N_HISTORY_SAMPLES           = 128;
 
 namespace gui {
 
 class EditParameterModal {
 private:
-	ws::IController& _wsController;
-	vts::Parameter&  _editingParameter;
+	ws::IController&       _wsController;
+	vts::ParameterManager& _parameterManager;
+	vts::Parameter&        _editingParameter;
 
 	AddImpulseModal _addImpulseModal;
 	ComboBox        _blendModeSelector;
+	ComboBox        _quantizationSelector;
 
 	char        _nameFieldBuffer[MAX_NAME_BUFFER_LENGTH];
 	std::string _initialName;
 
+	char                  _expressionBuffer[MAX_EXPRESSION_BUFFER_LENGTH];
+	vts::ExpressionResult _expressionError;
+
 	std::array<float, N_HISTORY_SAMPLES> _outputHistory;
 	int                                  _outputOffset;
 
-	imp::Code _impulseCodeToDelete;
+	imp::Code   _impulseCodeToDelete;
+	std::string _linkToDelete;
+	std::string _linkError;
 
 	void showAddImpulse();
+	void showAddLink();
 	void showImpulses();
+	void showLinks();
 	void showMeta();
 	void showOutput();
 
 	int        restrictInputName(ImGuiInputTextCallbackData* data);
 	static int inputNameCallback(ImGuiInputTextCallbackData* data);
+	void       addLink(const std::string& source);
 	void       checkDeleteImpulse();
+	void       checkDeleteLink();
 	void       save();
 	void       updateBlendMode();
+	void       updateExpression();
 
 public:
-	EditParameterModal(ws::IController& wsController,
-	                   vts::Parameter&  editingParameter);
+	EditParameterModal(ws::IController&       wsController,
+	                   vts::ParameterManager& parameterManager,
+	                   vts::Parameter&        editingParameter);
 
 	void refresh();
 	void show();
@@ -4,14 +4,23 @@
 #include <SDL3/SDL_events.h>
 #include <SDL3/SDL_stdinc.h>
 
+namespace vts {
+class ParameterBatch;
+}  // namespace vts
+
 namespace gui {
 
 enum Event : Uint32 {
 	THEME_HUE_CHANGE = SDL_EVENT_USER + 4,
+	PARAMETER_BATCH  = THEME_HUE_CHANGE + 1,
 };
 
 void allocateEvents();
 
+// Hands the batch to the main loop, which owns the VTS session that waits for
+// its responses.
+void pushParameterBatch(vts::ParameterBatch&& batch);
+
 }  // namespace gui
 
 #endif  // GUI_EVENT_HPP_
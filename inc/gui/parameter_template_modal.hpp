@@ -2,7 +2,7 @@
 #define GUI_PARAMETER_TEMPLATE_MODAL_
 
 #include "gui/combo_box.hpp"
-#include "ws/controller.hpp"
+#include "vts/parameter_batch.hpp"
 
 namespace gui {
 
@@ -19,8 +19,8 @@ public:
 
 	[[nodiscard]] virtual bool isValid() const = 0;
 
-	virtual void execute(ws::IController& wsController) = 0;
-	virtual void show()                                 = 0;
+	virtual void execute(vts::ParameterBatch& batch) = 0;
+	virtual void show()                              = 0;
 };
 
 class BrushTemplate : public ITemplate {
@@ -28,15 +28,15 @@ private:
 	bool _hasPosition;
 	bool _hasStroke;
 
-	static void createPositionParameters(ws::IController& wsController);
-	static void createStrokeParameters(ws::IController& wsController);
+	static void createPositionParameters(vts::ParameterBatch& batch);
+	static void createStrokeParameters(vts::ParameterBatch& batch);
 
 public:
 	BrushTemplate();
 
 	[[nodiscard]] bool isValid() const override;
 
-	void execute(ws::IController& wsController) override;
+	void execute(vts::ParameterBatch& batch) override;
 	void show() override;
 };
 
@@ -50,24 +50,22 @@ private:
 	bool _useController;
 	bool _useMouseKeyboard;
 
-	void createPressParameters(ws::IController& wsController) const;
-	void createShoulderParameters(ws::IController& wsController) const;
-	void createStickParameters(ws::IController& wsController) const;
-	void createTriggerParameters(ws::IController& wsController) const;
+	void createPressParameters(vts::ParameterBatch& batch) const;
+	void createShoulderParameters(vts::ParameterBatch& batch) const;
+	void createStickParameters(vts::ParameterBatch& batch) const;
+	void createTriggerParameters(vts::ParameterBatch& batch) const;
 
 public:
 	ControllerTemplate();
 
 	[[nodiscard]] bool isValid() const override;
 
-	void execute(ws::IController& wsController) override;
+	void execute(vts::ParameterBatch& batch) override;
 	void show() override;
 };
 
 class ParameterTemplateModal {
 private:
-	ws::IController& _wsController;
-
 	ComboBox _templateSelector;
 
 	BrushTemplate      _brushTemplate;
@@ -79,7 +77,7 @@ private:
 	void showCloseButtons();
 
 public:
-	explicit ParameterTemplateModal(ws::IController& wsController);
+	ParameterTemplateModal();
 
 	void show();
 
@@ -0,0 +1,103 @@
+#ifndef IMPULSE_CLIP_HPP_
+#define IMPULSE_CLIP_HPP_
+
+#include <cstddef>
+#include <optional>
+#include <string>
+#include <vector>
+
+#include <SDL3/SDL_stdinc.h>
+
+#include "impulse/code.hpp"
+
+namespace imp {
+
+enum class Interpolation : Uint8 {
+	LINEAR,
+	CUBIC,
+};
+
+struct Keyframe {
+	float time  = 0.0F;
+	float value = 0.0F;
+};
+
+struct ClipTrack {
+	Uint16                channel       = 0;
+	Interpolation         interpolation = Interpolation::LINEAR;
+	std::vector<Keyframe> keyframes;
+};
+
+struct Clip {
+	std::string            name;
+	std::string            hotkey;
+	std::vector<ClipTrack> tracks;
+};
+
+using Clips = std::vector<Clip>;
+
+constexpr Code makeClipCode(const Uint16 channel) {
+	return EventTag::CLIP | (static_cast<Code>(channel) << 16);
+}
+
+std::optional<Clips> loadClips();
+
+class ClipPlayer {
+private:
+	struct Playback {
+		const ClipTrack* track;
+		Code             code;
+		float            time;
+		std::size_t      cursor;
+		std::size_t      clip;
+	};
+
+	Clips                 _clips;
+	std::vector<Code>     _hotkeys;
+	std::vector<Playback> _playbacks;
+	std::vector<Code>     _released;
+
+	static float sample(const ClipTrack& track, std::size_t& cursor, float time);
+
+	[[nodiscard]] bool isPlaying(Code code) const;
+
+public:
+	ClipPlayer();
+
+	[[nodiscard]] const Clips& getClips() const;
+
+	void load(Clips clips);
+	void play(std::size_t clip);
+	bool trigger(Code code);
+
+	// Finished tracks release their channel to 0, like a key coming up, unless
+	// another clip is still playing on it.
+	template <typename Fn>
+	void update(const float dtS, Fn&& emit) {
+		for (const Code code : _released) {
+			emit(code, 0.0F);
+		}
+		_released.clear();
+		std::erase_if(_playbacks, [&](Playback& playback) {
+			const auto& keyframes = playback.track->keyframes;
+			playback.time += dtS;
+			if (playback.time >= keyframes.back().time) {
+				_released.push_back(playback.code);
+				return true;
+			}
+			emit(playback.code,
+			     sample(*playback.track, playback.cursor, playback.time));
+			return false;
+		});
+		for (const Code code : _released) {
+			if (!isPlaying(code)) {
+				emit(code, 0.0F);
+			}
+		}
+		_released.clear();
+	}
+};
+
+}  // namespace imp
+
+#endif  // IMPULSE_CLIP_HPP_
@@ -33,6 +33,8 @@ struct EventTag {
 	static constexpr T GAMEPAD_STICK_LEFT  = 7;
 	static constexpr T GAMEPAD_STICK_RIGHT = 8;
 	static constexpr T MOUSE_WHEEL         = 9;
+	static constexpr T GENERATOR           = 10;
+	static constexpr T CLIP                = 11;
 
 	EventTag() = delete;
 };
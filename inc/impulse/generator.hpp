@@ -0,0 +1,66 @@
+#ifndef IMPULSE_GENERATOR_HPP_
+#define IMPULSE_GENERATOR_HPP_
+
+#include <cstddef>
+#include <span>
+#include <vector>
+
+#include <SDL3/SDL_stdinc.h>
+
+#include "impulse/code.hpp"
+
+namespace imp {
+
+enum class Waveform : Uint8 {
+	SINE,
+	TRIANGLE,
+	NOISE,
+	BLINK,
+};
+
+struct GeneratorConfig {
+	Uint16   id       = 0;
+	Waveform waveform = Waveform::SINE;
+	float    rate     = 0.25F;
+	float    phase    = 0.0F;
+};
+
+constexpr Code makeGeneratorCode(const Uint16 id) {
+	return EventTag::GENERATOR | (static_cast<Code>(id) << 16);
+}
+
+class GeneratorBank {
+private:
+	std::vector<Code>   _codes;
+	std::vector<float>  _rates;
+	std::vector<float>  _phases;
+	std::vector<float>  _clocks;
+	std::vector<Uint32> _cells;
+	std::vector<Uint32> _seeds;
+	std::vector<float>  _outputs;
+
+	std::size_t _triangleBegin;
+	std::size_t _noiseBegin;
+	std::size_t _blinkBegin;
+
+	[[nodiscard]] Waveform getWaveform(std::size_t index) const;
+
+	void advance(float dtS);
+	void evaluateBlinks(float dtS);
+	void evaluateNoise();
+	void evaluateSines();
+	void evaluateTriangles();
+
+public:
+	GeneratorBank();
+
+	[[nodiscard]] std::span<const Code>  codes() const;
+	[[nodiscard]] std::span<const float> outputs() const;
+
+	void configure(const std::vector<GeneratorConfig>& configs);
+	void update(float dtS);
+};
+
+}  // namespace imp
+
+#endif  // IMPULSE_GENERATOR_HPP_
@@ -1,6 +1,7 @@
 #ifndef IMPULSE_PROCESSOR_HPP_
 #define IMPULSE_PROCESSOR_HPP_
 
+#include <unordered_set>
 #include <utility>
 #include <vector>
 
@@ -8,7 +9,9 @@
 #include <SDL3/SDL_joystick.h>
 #include <SDL3/SDL_stdinc.h>
 
+#include "impulse/clip.hpp"
 #include "impulse/code.hpp"
+#include "impulse/generator.hpp"
 #include "math/geometry.hpp"
 
 namespace imp {
@@ -33,6 +36,15 @@ private:
 	MouseState           _mouseState;
 	Uint64               _lastUpdateTimeMs;
 
+	GeneratorBank                _generators;
+	std::vector<GeneratorConfig> _generatorConfigs;
+	std::vector<float>           _generatorOutputs;
+
+	ClipPlayer _clips;
+
+	// Keys currently down, so OS auto-repeat doesn't restart their clips.
+	std::unordered_set<Uint32> _heldKeys;
+
 	ImpulseQueue _queue;
 
 	void handleGamepadAxisMotion(SDL_GamepadAxisEvent& event);
@@ -44,6 +56,9 @@ private:
 	void handleMouseMove(SDL_UserEvent& event);
 	void handleMouseWheel(SDL_UserEvent& event);
 
+	void configureGenerators(const std::vector<GeneratorConfig>& generators);
+	void updateClips(Uint64 dtMs);
+	void updateGenerators(Uint64 dtMs);
 	void updateMouseMovement(Uint64 dtMs);
 	void updateMouseWheel(Uint64 dtMs);
 
@@ -52,14 +67,18 @@ public:
 	Processor(Processor&)            = delete;
 	Processor& operator=(Processor&) = delete;
 
-	[[nodiscard]] const ImpulseQueue&         impulses() const;
-	[[nodiscard]] const math::Rectangle<int>& getMouseBounds() const;
-	[[nodiscard]] const MouseState&           getMouseState() const;
-	[[nodiscard]] int                         getMouseSensitivity() const;
+	[[nodiscard]] const Clips&                        getClips() const;
+	[[nodiscard]] const ImpulseQueue&                 impulses() const;
+	[[nodiscard]] const math::Rectangle<int>&         getMouseBounds() const;
+	[[nodiscard]] const MouseState&                   getMouseState() const;
+	[[nodiscard]] const std::vector<GeneratorConfig>& getGenerators() const;
+	[[nodiscard]] int                                 getMouseSensitivity() const;
 
 	void clear();
 	void handleGamepadEvent(SDL_Event& event, SDL_JoystickID activeGamepadId);
 	void handleEvent(SDL_UserEvent& event);
+	void reloadClips();
+	void setGenerators(const std::vector<GeneratorConfig>& generators);
 	void setMouseBounds(const math::Rectangle<int>& bounds);
 	void setMouseSensitivity(int sensitivity);
 	void update();
@@ -1,6 +1,8 @@
 #ifndef IMPULSE_RECEIVER_HPP_
 #define IMPULSE_RECEIVER_HPP_
 
+#include <cstddef>
+
 #include "impulse/code.hpp"
 
 namespace imp {
@@ -9,24 +11,27 @@ class Receiver {
 private:
 	const Code _code;
 
-	bool  _isInverted;
-	float _inMax;
-	float _inMin;
-	float _outMax;
-	float _outMin;
-	float _value;
+	bool        _isInverted;
+	float       _inMax;
+	float       _inMin;
+	float       _outMax;
+	float       _outMin;
+	float       _value;
+	std::size_t _lane;
 
 public:
 	explicit Receiver(Code code, bool isInverted = false);
 
-	[[nodiscard]] bool  getIsInverted() const;
-	[[nodiscard]] Code  getCode() const;
-	[[nodiscard]] float getMax() const;
-	[[nodiscard]] float getMin() const;
-	[[nodiscard]] float getValue() const;
+	[[nodiscard]] bool        getIsInverted() const;
+	[[nodiscard]] Code        getCode() const;
+	[[nodiscard]] float       getMax() const;
+	[[nodiscard]] float       getMin() const;
+	[[nodiscard]] float       getValue() const;
+	[[nodiscard]] std::size_t getLane() const;
 
-	bool& isInvertedRef();
-	void  update(float value);
+	void setInverted(bool isInverted);
+	void setLane(std::size_t lane);
+	void update(float value);
 };
 
 }  // namespace imp
@@ -0,0 +1,15 @@
+#ifndef IMPULSE_SYMBOL_HPP_
+#define IMPULSE_SYMBOL_HPP_
+
+#include <optional>
+#include <string_view>
+
+#include "impulse/code.hpp"
+
+namespace imp {
+
+std::optional<Code> findSymbol(std::string_view name);
+
+}  // namespace imp
+
+#endif  // IMPULSE_SYMBOL_HPP_
@@ -0,0 +1,79 @@
+#ifndef MATH_EXPRESSION_HPP_
+#define MATH_EXPRESSION_HPP_
+
+#include <cstddef>
+#include <expected>
+#include <functional>
+#include <optional>
+#include <span>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include <SDL3/SDL_stdinc.h>
+
+namespace math {
+
+enum class OpCode : Uint8 {
+	LOAD_CONSTANT,
+	LOAD_VARIABLE,
+	NEGATE,
+	ADD,
+	SUBTRACT,
+	MULTIPLY,
+	DIVIDE,
+	LESS,
+	LESS_EQUAL,
+	GREATER,
+	GREATER_EQUAL,
+	EQUAL,
+	NOT_EQUAL,
+	SELECT,
+	ABS,
+	SIGN,
+	MIN,
+	MAX,
+	CLAMP,
+	DEADZONE,
+	REMAP,
+	SMOOTHSTEP,
+};
+
+// Operands of an instruction live in consecutive registers starting at
+// `reg`, and its result replaces the first of them.
+struct Instruction {
+	OpCode op;
+	Uint8  reg;
+	Uint16 variable;
+	float  constant;
+};
+
+struct ExpressionError {
+	std::size_t position;
+	std::string message;
+};
+
+using SymbolResolver =
+    std::function<std::optional<std::size_t>(std::string_view name)>;
+
+class Expression {
+private:
+	std::vector<Instruction> _program;
+
+public:
+	static constexpr std::size_t MAX_REGISTERS = 32;
+
+	Expression();
+
+	static std::expected<Expression, ExpressionError> compile(
+	    std::string_view      source,
+	    const SymbolResolver& resolve);
+
+	[[nodiscard]] bool        isEmpty() const;
+	[[nodiscard]] float       evaluate(std::span<const float> variables) const;
+	[[nodiscard]] std::size_t size() const;
+};
+
+}  // namespace math
+
+#endif  // MATH_EXPRESSION_HPP_
@@ -1,6 +1,9 @@
 #ifndef MATH_FORMULA_HPP_
 #define MATH_FORMULA_HPP_
 
+#include <algorithm>
+#include <cmath>
+
 namespace math {
 
 template <typename T>
@@ -34,6 +37,28 @@ constexpr T remapLinearDeadzone(const T inValue,
 	return T{0};
 }
 
+template <typename T>
+constexpr T deadzone(const T value, const T threshold) {
+	return remapLinearDeadzone(value, T{-1}, T{1}, T{-1}, T{1}, threshold);
+}
+
+template <typename T>
+constexpr T smoothstep(const T edge0, const T edge1, const T value) {
+	if (edge1 == edge0) {
+		return value < edge0 ? T{0} : T{1};
+	}
+	const T t = std::clamp((value - edge0) / (edge1 - edge0), T{0}, T{1});
+	return t * t * (T{3} - T{2} * t);
+}
+
+template <typename T>
+T quantize(const T value, const T steps) {
+	if (steps <= T{0}) {
+		return value;
+	}
+	return std::round(value * steps) / steps;
+}
+
 template <typename T>
 constexpr T sign(const T x) {
 	if (x > T{0})
@@ -0,0 +1,32 @@
+#ifndef MATH_REDUCE_HPP_
+#define MATH_REDUCE_HPP_
+
+#include <cstddef>
+#include <span>
+
+namespace math {
+
+struct ReduceKernels {
+	const char* name;
+
+	float (*sum)(const float* values, size_t n);
+	float (*max)(const float* values, size_t n, float initial);
+	float (*min)(const float* values, size_t n, float initial);
+	float (*major)(const float* values, size_t n, float origin);
+};
+
+const ReduceKernels& scalarReduceKernels();
+const ReduceKernels& reduceKernels();
+
+// The vector kernels add their lanes in a different order from the scalar
+// loop and from each other, so a sum can differ from the scalar result by
+// float rounding. The max, min and major reductions are exact on every
+// path.
+float reduceSum(std::span<const float> values);
+float reduceMax(std::span<const float> values, float initial);
+float reduceMin(std::span<const float> values, float initial);
+float reduceMajor(std::span<const float> values, float origin);
+
+}  // namespace math
+
+#endif  // MATH_REDUCE_HPP_
@@ -0,0 +1,70 @@
+#ifndef VTS_ITEM_HPP_
+#define VTS_ITEM_HPP_
+
+#include <array>
+#include <cstddef>
+#include <string>
+
+#include <SDL3/SDL_stdinc.h>
+
+#include "impulse/code.hpp"
+#include "vts/parameter.hpp"
+#include "vts/request.hpp"
+
+namespace vts {
+
+enum class ItemChannel : Uint8 {
+	POSITION_X,
+	POSITION_Y,
+	ROTATION,
+	SIZE,
+	COUNT,
+};
+
+constexpr std::size_t N_ITEM_CHANNELS = static_cast<std::size_t>(
+    ItemChannel::COUNT);
+
+// An item in the VTS scene. Instance ids change whenever an item is loaded,
+// so bindings are configured by file name and resolved at runtime.
+struct ItemInstance {
+	std::string fileName;
+	std::string instanceId;
+};
+
+// Where a channel's normalized output is mapped to, in VTS units: positions
+// span -1 to 1 across the screen, rotation is in degrees and size runs 0 to 1.
+struct ItemRange {
+	float low  = 0.0F;
+	float high = 1.0F;
+};
+
+// Moves a VTS item from impulses. Each channel is a Parameter, so it blends,
+// quantizes and filters by epsilon like any other output, and only channels
+// that changed are sent.
+class ItemBinding {
+private:
+	std::string                            _fileName;
+	std::string                            _instanceId;
+	std::array<Parameter, N_ITEM_CHANNELS> _channels;
+	std::array<ItemRange, N_ITEM_CHANNELS> _ranges;
+	Uint8                                  _changed;
+
+	float getValue(std::size_t channel) const;
+
+public:
+	explicit ItemBinding(const std::string& fileName);
+
+	const std::string& getFileName() const;
+	const std::string& getInstanceId() const;
+	Parameter&         getChannel(ItemChannel channel);
+	bool               isBound() const;
+
+	bool     handleImpulse(imp::Code code, float value);
+	ItemMove takeMove();
+	void     setInstanceId(const std::string& instanceId);
+	void     setRange(ItemChannel channel, ItemRange range);
+};
+
+}  // namespace vts
+
+#endif  // VTS_ITEM_HPP_
@@ -0,0 +1,41 @@
+#ifndef VTS_ITEM_MANAGER_HPP_
+#define VTS_ITEM_MANAGER_HPP_
+
+#include <span>
+#include <string>
+#include <vector>
+
+#include "core/bitset.hpp"
+#include "impulse/code.hpp"
+#include "vts/item.hpp"
+#include "vts/request.hpp"
+
+namespace vts {
+
+// Owns the item bindings and gathers the moves of every item that changed
+// into one ItemMoveRequest at a time.
+class ItemManager {
+private:
+	std::vector<ItemBinding> _items;
+	core::DynamicBitset      _dirty;
+	std::vector<ItemMove>    _moves;
+
+public:
+	ItemManager();
+	ItemManager(ItemManager&)            = delete;
+	ItemManager& operator=(ItemManager&) = delete;
+
+	bool isEmpty() const;
+
+	ItemBinding&              add(const std::string& fileName);
+	void                      bind(const ItemInstance& instance);
+	void                      bindAll(std::span<const ItemInstance> instances);
+	void                      clear();
+	std::span<const ItemMove> collectMoves();
+	void                      distributeImpulse(imp::Code code, float value);
+	void                      unbind(const std::string& instanceId);
+};
+
+}  // namespace vts
+
+#endif  // VTS_ITEM_MANAGER_HPP_
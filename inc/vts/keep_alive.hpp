@@ -0,0 +1,46 @@
+#ifndef VTS_KEEP_ALIVE_HPP_
+#define VTS_KEEP_ALIVE_HPP_
+
+#include <cstddef>
+#include <vector>
+
+#include <SDL3/SDL_stdinc.h>
+
+namespace vts {
+
+class KeepAlive {
+private:
+	const Uint64        _intervalNs;
+	const Uint64        _staleNs;
+	Uint64              _lastTickNs;
+	double              _credit;
+	std::size_t         _cursor;
+	std::vector<Uint64> _lastSentNs;
+
+	std::size_t takeBudget(Uint64 nowNs);
+
+public:
+	KeepAlive();
+
+	void markSent(std::size_t index, Uint64 nowNs);
+	void resize(std::size_t size);
+
+	template <typename Fn>
+	void collect(const Uint64 nowNs, Fn&& fn) {
+		const std::size_t budget = takeBudget(nowNs);
+		for (std::size_t i = 0; i < budget; ++i) {
+			const std::size_t index = _cursor;
+			_cursor                 = (_cursor + 1) % _lastSentNs.size();
+			if (nowNs - _lastSentNs[index] < _staleNs) {
+				continue;
+			}
+			if (fn(index)) {
+				_lastSentNs[index] = nowNs;
+			}
+		}
+	}
+};
+
+}  // namespace vts
+
+#endif  // VTS_KEEP_ALIVE_HPP_
@@ -0,0 +1,55 @@
+#ifndef VTS_MIRROR_HPP_
+#define VTS_MIRROR_HPP_
+
+#include <cstddef>
+#include <span>
+#include <string>
+#include <vector>
+
+#include <SDL3/SDL_events.h>
+#include <SDL3/SDL_stdinc.h>
+
+#include "vts/request.hpp"
+#include "vts/session.hpp"
+#include "ws/client.hpp"
+
+namespace vts {
+
+// A further VTS instance fed the values evaluated for the primary one. It
+// runs its own handshake and keeps track of which plugin parameters it has,
+// so it is only sent values it can apply. A dropped or refused connection is
+// retried with exponential backoff.
+class Mirror {
+private:
+	ws::Client               _client;
+	Session                  _session;
+	std::vector<std::string> _available;
+	bool                     _isModelLoaded;
+	Uint64                   _retryDelayNs;
+	Uint64                   _nextRetryNs;
+
+	void handleParameterList(const SDL_UserEvent& event);
+	Task startSession();
+
+public:
+	explicit Mirror(std::size_t instance);
+	Mirror(Mirror&)            = delete;
+	Mirror& operator=(Mirror&) = delete;
+	~Mirror();
+
+	[[nodiscard]] ws::Client& getClient();
+
+	bool covers(std::span<const ParameterValue> values) const;
+	void filter(std::span<const ParameterValue> values,
+	            std::vector<ParameterValue>&    available) const;
+	bool isReady();
+
+	void checkReconnect(Uint64 nowNs);
+	void expire();
+	void handleMessage(SDL_UserEvent& event);
+	void handleOpen();
+};
+
+}  // namespace vts
+
+#endif  // VTS_MIRROR_HPP_
@@ -0,0 +1,67 @@
+#ifndef VTS_MODEL_CACHE_HPP_
+#define VTS_MODEL_CACHE_HPP_
+
+#include <map>
+#include <string>
+#include <vector>
+
+namespace vts {
+
+// A plugin parameter as VTS reports it.
+struct ParameterInfo {
+	std::string name;
+	float       min          = 0.0F;
+	float       max          = 0.0F;
+	float       defaultValue = 0.0F;
+
+	bool operator==(const ParameterInfo&) const = default;
+};
+
+// Payload of an INPUT_PARAMETER_LIST response.
+struct ParameterList {
+	bool                       modelLoaded = false;
+	std::string                modelId;
+	std::string                modelName;
+	std::vector<ParameterInfo> parameters;
+};
+
+// Payload of a MODEL_LOADED event, pushed by VTS whenever a model is loaded
+// or unloaded.
+struct ModelStatus {
+	bool        modelLoaded = false;
+	std::string modelId;
+	std::string modelName;
+};
+
+struct CachedModel {
+	std::string                name;
+	std::vector<ParameterInfo> parameters;
+};
+
+// Remembers the parameter list last seen for each model, persisted to
+// models.json, so a session can be set up from the cache before VTS answers.
+class ModelCache {
+private:
+	std::string                        _activeId;
+	std::map<std::string, CachedModel> _models;
+
+	void load();
+	void save() const;
+
+public:
+	ModelCache();
+	ModelCache(ModelCache&)            = delete;
+	ModelCache& operator=(ModelCache&) = delete;
+
+	[[nodiscard]] const CachedModel* find(const std::string& modelId) const;
+	[[nodiscard]] const CachedModel* getActive() const;
+
+	void store(const ParameterList& list);
+};
+
+std::vector<std::string> getNames(
+    const std::vector<ParameterInfo>& parameters);
+
+}  // namespace vts
+
+#endif  // VTS_MODEL_CACHE_HPP_
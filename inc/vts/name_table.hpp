@@ -0,0 +1,48 @@
+#ifndef VTS_NAME_TABLE_HPP_
+#define VTS_NAME_TABLE_HPP_
+
+#include <cstddef>
+#include <deque>
+#include <string_view>
+#include <unordered_map>
+
+#include <SDL3/SDL_stdinc.h>
+
+#include "core/meta.hpp"
+
+namespace vts {
+
+using NameId = Uint32;
+
+class ParameterName {
+private:
+	char  _data[core::MAX_PARAMETER_LENGTH + 1];
+	Uint8 _length;
+
+public:
+	explicit ParameterName(std::string_view name);
+
+	[[nodiscard]] std::string_view view() const;
+};
+
+// Names are never evicted, so an id stays valid (and keeps pointing at the
+// same characters) for the lifetime of the table.
+class NameTable {
+private:
+	std::deque<ParameterName>                    _names;
+	std::unordered_map<std::string_view, NameId> _ids;
+
+public:
+	NameTable();
+	NameTable(NameTable&)            = delete;
+	NameTable& operator=(NameTable&) = delete;
+
+	[[nodiscard]] std::size_t      size() const;
+	[[nodiscard]] std::string_view view(NameId id) const;
+
+	NameId intern(std::string_view name);
+};
+
+}  // namespace vts
+
+#endif  // VTS_NAME_TABLE_HPP_
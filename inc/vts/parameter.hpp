@@ -1,13 +1,18 @@
 #ifndef VTS_PARAMETER_HPP_
 #define VTS_PARAMETER_HPP_
 
+#include <cstddef>
+#include <optional>
+#include <span>
 #include <string>
 #include <unordered_map>
+#include <vector>
 
 #include <SDL3/SDL_stdinc.h>
 
 #include "impulse/code.hpp"
 #include "impulse/receiver.hpp"
+#include "math/expression.hpp"
 
 namespace vts {
 
@@ -16,22 +21,59 @@ enum class BlendMode : Uint8 {
 	BOUNDED_SUM,
 };
 
+struct ParameterLink {
+	std::string source;
+	float       weight = 1.0F;
+	float       value  = 0.0F;
+	float       min    = 0.0F;
+	float       max    = 1.0F;
+};
+
 using ImpulseReceiverMap = std::unordered_map<imp::Code, imp::Receiver>;
+using ExpressionResult   = std::optional<math::ExpressionError>;
+using ParameterLinks     = std::vector<ParameterLink>;
 
+// Inputs are laid out as links, then bound receivers, then receivers that
+// only the expression reads. Only the first `_blendInputCount` of them are
+// blended and bound the range; the rest just feed the expression.
 class Parameter {
 private:
+	std::size_t        _blendInputCount;
 	BlendMode          _blendMode;
-	bool               _fresh;
 	float              _defaultValue;
+	float              _epsilon;
 	float              _max;
 	float              _min;
 	float              _output;
+	int                _quantization;
+	float              _springDamping;
+	float              _springFrequency;
+	float              _target;
 	ImpulseReceiverMap _impulseReceivers;
+	ParameterLinks     _links;
 	std::string        _name;
+	std::vector<float> _inputs;
+	std::vector<float> _inputMaxs;
+	std::vector<float> _inputMins;
+
+	math::Expression         _expression;
+	std::string              _expressionSource;
+	std::vector<imp::Code>   _expressionCodes;
+	std::vector<std::size_t> _expressionLanes;
+	std::vector<float>       _expressionValues;
+
+	// Receivers that exist only because the expression reads them.
+	std::vector<imp::Code> _expressionReceivers;
+
+	bool  commitOutput(float value);
+	bool  isSignificant(float value) const;
+	bool  updateOutput();
+	float calcImpulseSum() const;
+	float calcMajorImpulse() const;
 
-	float calcImpulseSum();
-	float calcMajorImpulse();
-	void  updateOutput();
+	std::span<const float> getBlendInputs() const;
+	float evaluateExpression(float blend);
+	void  rebuildInputs();
 
 public:
 	Parameter();
@@ -39,21 +81,41 @@ public:
 
 	BlendMode                 getBlendMode() const;
 	bool                      hasImpulses() const;
-	bool                      isFresh();
+	bool                      hasSpring() const;
+	bool                      isExpressionInput(imp::Code code) const;
+	bool                      isResting() const;
 	const imp::Receiver&      getReceiver(imp::Code code) const;
 	const ImpulseReceiverMap& getReceivers() const;
+	const ParameterLinks&     getLinks() const;
+	const std::string&        getExpression() const;
 	const std::string&        getName() const;
+	float                     getEpsilon() const;
 	float                     getMax() const;
 	float                     getMin() const;
 	float                     getNormalized() const;
 	float                     getOutput() const;
+	float                     getSpringDamping() const;
+	float                     getSpringFrequency() const;
+	float                     getTarget() const;
+	int                       getQuantization() const;
+	ExpressionResult          setExpression(const std::string& source);
 	ImpulseReceiverMap&       getReceivers();
+	ParameterLinks&           getLinks();
 	void                      addImpulse(imp::Code code, bool isInverted = false);
+	void                      addLink(const std::string& source, float weight);
 	void                      clearImpulses();
-	void                      handleImpulse(imp::Code code, float value);
+	bool                      handleImpulse(imp::Code code, float value);
+	bool                      handleLink(std::size_t link, float value);
+	bool                      handleSpring(float position);
 	void                      removeImpulse(imp::Code code);
+	void                      removeLink(const std::string& source);
 	void                      setBlendMode(BlendMode mode);
+	void                      setEpsilon(float epsilon);
+	bool                      setInverted(imp::Code code, bool isInverted);
+	bool                      setLinkRange(std::size_t link, float min, float max);
 	void                      setName(const std::string& name);
+	void                      setQuantization(int steps);
+	void                      setSpring(float frequency, float damping);
 	void                      updateBounds();
 };
 
@@ -0,0 +1,38 @@
+#ifndef VTS_PARAMETER_BATCH_HPP_
+#define VTS_PARAMETER_BATCH_HPP_
+
+#include <string>
+#include <vector>
+
+#include <SDL3/SDL_stdinc.h>
+
+#include "vts/parameter.hpp"
+#include "ws/controller.hpp"
+
+namespace vts {
+
+// Groups parameter creations and deletions so their settings are written once
+// and their requests go out back to back instead of one round trip apiece.
+class ParameterBatch {
+private:
+	std::vector<Parameter>   _creations;
+	std::vector<std::string> _deletions;
+
+public:
+	ParameterBatch();
+
+	[[nodiscard]] const std::vector<Parameter>&   getCreations() const;
+	[[nodiscard]] const std::vector<std::string>& getDeletions() const;
+	[[nodiscard]] bool                            isEmpty() const;
+
+	void create(const Parameter& parameter);
+	void remove(const std::string& name);
+
+	// Commits settings, then sends every request. Returns the ids that were
+	// sent so the caller can wait for all of them.
+	std::vector<Uint64> send(ws::IController& wsController) const;
+};
+
+}  // namespace vts
+
+#endif  // VTS_PARAMETER_BATCH_HPP_
@@ -1,39 +1,95 @@
 #ifndef VTS_PARAMETER_MANAGER_HPP_
 #define VTS_PARAMETER_MANAGER_HPP_
 
-#include <ranges>
+#include <cstddef>
+#include <span>
 #include <string>
 #include <unordered_map>
 #include <utility>
+#include <vector>
 
+#include <SDL3/SDL_stdinc.h>
+
+#include "core/bitset.hpp"
 #include "impulse/code.hpp"
+#include "vts/keep_alive.hpp"
+#include "vts/name_table.hpp"
 #include "vts/parameter.hpp"
+#include "vts/spring.hpp"
 
 namespace vts {
 
-using ParameterStore = std::unordered_map<std::string, Parameter>;
+struct ParameterEdge {
+	std::size_t target;
+	std::size_t link;
+};
 
-using ParameterView =
-    decltype(std::declval<ParameterStore&>() | std::views::values);
+using ParameterStore = std::vector<Parameter>;
+using ParameterIndex = std::unordered_map<std::string, std::size_t>;
+using ParameterView  = std::span<Parameter>;
+using ParameterEdges = std::vector<std::vector<ParameterEdge>>;
 
 class ParameterManager {
 private:
-	Parameter      _sample;
-	ParameterStore _parameters;
+	Parameter           _sample;
+	ParameterStore      _parameters;
+	ParameterIndex      _indices;
+	NameTable           _names;
+	std::vector<NameId> _nameIds;
+	core::DynamicBitset _dirty;
+	KeepAlive           _keepAlive;
+
+	ParameterEdges           _dependents;
+	std::vector<std::size_t> _order;
+	std::vector<std::size_t> _ranks;
+	core::DynamicBitset      _pending;
+
+	SpringBank  _springs;
+	SpringState _sampleSpring;
+
+	void markChanged(std::size_t index);
+	void removeMissing(std::span<const std::string> names);
+	void seedLinks();
+	void updateSampleLinks();
 
 public:
 	ParameterManager();
 	ParameterManager(ParameterManager&)            = delete;
 	ParameterManager& operator=(ParameterManager&) = delete;
 
-	bool                     isEmpty() const;
-	Parameter&               getSample();
-	ParameterStore::iterator end();
-	ParameterStore::iterator find(const std::string& name);
-	ParameterView            values();
-	void                     add(const std::string& name);
-	void                     clear();
-	void                     distributeImpulse(imp::Code code, float value);
+	bool          createsCycle(const std::string&    target,
+	                           const ParameterLinks& links) const;
+	bool          isEmpty() const;
+	Parameter&    getSample();
+	Parameter*    find(const std::string& name);
+	Parameter*    reset(const std::string& name);
+	ParameterView values();
+	void          add(const std::string& name);
+	void          clear();
+	void          distributeImpulse(imp::Code code, float value);
+	void          markAllChanged();
+	void          propagate();
+	void          rebuildGraph();
+	void          rebuildSprings();
+	void          simulate(Uint64 nowNs);
+
+	std::vector<std::string> sync(std::span<const std::string> names);
+
+	template <typename Fn>
+	void collectPending(const Uint64 nowNs, Fn&& fn) {
+		_dirty.drain([&](const std::size_t index) {
+			_keepAlive.markSent(index, nowNs);
+			fn(_names.view(_nameIds[index]), std::as_const(_parameters[index]));
+		});
+		_keepAlive.collect(nowNs, [&](const std::size_t index) {
+			const auto& parameter = _parameters[index];
+			if (parameter.isResting()) {
+				return false;
+			}
+			fn(_names.view(_nameIds[index]), parameter);
+			return true;
+		});
+	}
 };
 
 }  // namespace vts
@@ -0,0 +1,31 @@
+#ifndef VTS_REFRESH_DEBOUNCER_HPP_
+#define VTS_REFRESH_DEBOUNCER_HPP_
+
+#include <SDL3/SDL_stdinc.h>
+
+namespace vts {
+
+// Coalesces parameter list refreshes: requests within the debounce window
+// collapse into one, and at most one list request is in flight at a time. A
+// refresh asked for while one is outstanding is sent after it resolves.
+class RefreshDebouncer {
+private:
+	const Uint64 _delayNs;
+	Uint64       _dueNs;
+	Uint64       _requestId;
+	bool         _isScheduled;
+
+public:
+	RefreshDebouncer();
+
+	[[nodiscard]] bool isInFlight() const;
+
+	void flush(Uint64 nowNs);
+	bool poll(Uint64 nowNs);
+	void schedule(Uint64 nowNs);
+	void setRequest(Uint64 requestId);
+};
+
+}  // namespace vts
+
+#endif  // VTS_REFRESH_DEBOUNCER_HPP_
@@ -1,10 +1,12 @@
 #ifndef VTS_REQUEST_HPP_
 #define VTS_REQUEST_HPP_
 
+#include <optional>
+#include <span>
 #include <string>
 #include <string_view>
-#include <vector>
 
+#include <SDL3/SDL_stdinc.h>
 #include <glaze/core/common.hpp>
 
 #include "vts/parameter.hpp"
@@ -12,9 +14,11 @@
 
 namespace vts {
 
+// Ids point into ParameterManager's name table and are only read while the
+// request is serialized.
 struct ParameterValue {
-	std::string id;
-	float       value;
+	std::string_view id;
+	float            value;
 
 	struct glaze {
 		using T                     = ParameterValue;
@@ -22,18 +26,86 @@ struct ParameterValue {
 	};
 };
 
-void authenticate(ws::IController& wsController);
+// One entry of an ItemMoveRequest. Channels left empty are not sent, which
+// leaves them where VTS has them; the move is applied instantly.
+struct ItemMove {
+	std::string_view     itemInstanceId;
+	std::optional<float> positionX;
+	std::optional<float> positionY;
+	std::optional<float> rotation;
+	std::optional<float> size;
+	float                timeInSeconds = 0.0F;
+	std::string_view     fadeMode      = "linear";
+	bool                 userCanStop   = false;
 
-void requestToken(ws::IController& wsController);
+	struct glaze {
+		using T                     = ItemMove;
+		static constexpr auto value = glz::object("itemInstanceID",
+		                                          &T::itemInstanceId,
+		                                          "positionX",
+		                                          &T::positionX,
+		                                          "positionY",
+		                                          &T::positionY,
+		                                          "rotation",
+		                                          &T::rotation,
+		                                          "size",
+		                                          &T::size,
+		                                          "timeInSeconds",
+		                                          &T::timeInSeconds,
+		                                          "fadeMode",
+		                                          &T::fadeMode,
+		                                          "userCanStop",
+		                                          &T::userCanStop);
+	};
+};
+
+// Writes InjectParameterDataRequests by appending the request id and values
+// between pieces of a pre-rendered envelope.
+class InjectionEncoder {
+private:
+	std::string _head;
+	std::string _prefix;
+	std::string _suffix;
+	int         _precision;
+
+public:
+	explicit InjectionEncoder(int precision);
+
+	void encode(Uint64                          requestId,
+	            std::span<const ParameterValue> values,
+	            std::string&                    buffer) const;
+	void setPrecision(int precision);
+};
+
+// Each returns the id the request was sent with, or 0 if it was not sent.
+
+Uint64 authenticate(ws::IController& wsController);
+
+Uint64 requestToken(ws::IController& wsController);
+
+Uint64 createParameter(ws::IController& wsController,
+                       const Parameter& parameter);
+
+Uint64 deleteParameter(ws::IController& wsController, std::string_view name);
+
+Uint64 getParameters(ws::IController& wsController);
+
+Uint64 getItems(ws::IController& wsController);
 
-void createParameter(ws::IController& wsController, const Parameter& parameter);
+Uint64 subscribeEvent(ws::IController& wsController,
+                      std::string_view eventName);
 
-void deleteParameter(ws::IController& wsController, std::string_view name);
+Uint64 moveItems(ws::IController&          wsController,
+                 std::span<const ItemMove> moves);
 
-void getParameters(ws::IController& wsController);
+void setParameters(ws::IController&                wsController,
+                   const InjectionEncoder&         encoder,
+                   std::span<const ParameterValue> values);
 
-void setParameters(ws::IController&             wsController,
-                   std::vector<ParameterValue>& values);
+// Serializes the values once and shares the message between connections.
+void setParameters(std::span<ws::IController* const> wsControllers,
+                   const InjectionEncoder&           encoder,
+                   std::span<const ParameterValue>   values);
 
 };  // namespace vts
 
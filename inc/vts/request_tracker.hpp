@@ -0,0 +1,105 @@
+#ifndef VTS_REQUEST_TRACKER_HPP_
+#define VTS_REQUEST_TRACKER_HPP_
+
+#include <array>
+#include <cstddef>
+#include <string_view>
+
+#include <SDL3/SDL_stdinc.h>
+
+namespace vts {
+
+enum class RequestType : Uint8 {
+	AUTHENTICATION,
+	AUTHENTICATION_TOKEN,
+	INPUT_PARAMETER_LIST,
+	PARAMETER_CREATION,
+	PARAMETER_DELETION,
+	INJECT_PARAMETER_DATA,
+	EVENT_SUBSCRIPTION,
+	ITEM_LIST,
+	ITEM_MOVE,
+	COUNT,
+};
+
+constexpr std::size_t N_REQUEST_TYPES = static_cast<std::size_t>(
+    RequestType::COUNT);
+
+std::string_view getMessageType(RequestType type);
+
+// Round-trip times in microseconds, bucketed HDR-style: exact below 8 us,
+// then eight linear sub-buckets per power of two (12.5% resolution).
+class LatencyHistogram {
+private:
+	static constexpr Uint64      SUB_BUCKETS = 8;
+	static constexpr std::size_t N_BUCKETS   = 192;
+
+	std::array<Uint32, N_BUCKETS> _counts;
+	Uint64                        _total;
+	Uint64                        _maxUs;
+
+	static std::size_t getBucket(Uint64 us);
+	static Uint64      getUpperBound(std::size_t bucket);
+
+public:
+	LatencyHistogram();
+
+	[[nodiscard]] Uint64 getCount() const;
+	[[nodiscard]] Uint64 getMaxUs() const;
+	[[nodiscard]] Uint64 getPercentileUs(double percentile) const;
+
+	void clear();
+	void record(Uint64 us);
+};
+
+// Hands out request ids and matches responses back to them. Only touched from
+// the main thread: responses arrive there as SDL events carrying their id.
+// Requests in flight live in a fixed ring indexed by id, so tracking one never
+// allocates. Ids only grow and skip over slots that are still taken, which
+// lets a slow request such as a token prompt outlive many quick ones.
+class RequestTracker {
+private:
+	static constexpr std::size_t N_SLOTS = 1024;
+
+	struct InFlight {
+		Uint64      id;
+		Uint64      sentNs;
+		std::size_t instance;
+		RequestType type;
+	};
+
+	Uint64                        _nextId;
+	std::size_t                   _inFlightCount;
+	std::array<InFlight, N_SLOTS> _inFlight;
+
+	std::array<LatencyHistogram, N_REQUEST_TYPES> _histograms;
+	std::array<Uint64, N_REQUEST_TYPES>           _timeouts;
+
+	RequestTracker();
+
+	[[nodiscard]] InFlight* find(Uint64 id);
+	void                    release(InFlight& slot);
+
+public:
+	static RequestTracker& instance();
+	RequestTracker(RequestTracker&)            = delete;
+	RequestTracker& operator=(RequestTracker&) = delete;
+
+	[[nodiscard]] const LatencyHistogram& getHistogram(RequestType type) const;
+	[[nodiscard]] std::size_t             getInFlight() const;
+	[[nodiscard]] Uint64                  getTimeouts(RequestType type) const;
+	[[nodiscard]] bool                    isInFlight(Uint64 id) const;
+
+	Uint64 begin(RequestType type, std::size_t instance, Uint64 nowNs);
+	void   cancel(Uint64 id);
+	void   clearInFlight(std::size_t instance);
+	void   clearStatistics();
+	bool   complete(Uint64 id, Uint64 nowNs);
+	void   expire(Uint64 nowNs);
+};
+
+}  // namespace vts
+
+#define REQUESTS (vts::RequestTracker::instance())
+
+#endif  // VTS_REQUEST_TRACKER_HPP_
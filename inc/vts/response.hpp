@@ -1,6 +1,8 @@
 #ifndef VTS_RESPONSE_HPP_
 #define VTS_RESPONSE_HPP_
 
+#include <string_view>
+
 #include <SDL3/SDL_events.h>
 #include <SDL3/SDL_stdinc.h>
 
@@ -15,9 +17,20 @@ enum ResponseCode : Sint32 {
 	INPUT_PARAMETER_LIST,
 	PARAMETER_CREATION,
 	PARAMETER_DELETION,
+	EVENT_SUBSCRIPTION,
+	MODEL_LOADED,
+	MODEL_CONFIG_CHANGED,
+	ITEM_LIST,
+	ITEM_ADDED,
+	ITEM_REMOVED,
 };
 
-void buildResponseEvent(SDL_UserEvent& user, char* jsonChars, int nChars);
+// Decodes a frame straight out of the socket buffer; the view only has to
+// outlive the call. The echoed request id is passed along in data2.
+void buildResponseEvent(SDL_UserEvent& user, std::string_view json);
+
+// Frees whatever buildResponseEvent attached to data1.
+void releaseResponse(SDL_UserEvent& user);
 
 }  // namespace vts
 
@@ -0,0 +1,85 @@
+#ifndef VTS_SESSION_HPP_
+#define VTS_SESSION_HPP_
+
+#include <coroutine>
+#include <exception>
+#include <unordered_map>
+
+#include <SDL3/SDL_events.h>
+#include <SDL3/SDL_stdinc.h>
+
+namespace vts {
+
+// Fire-and-forget coroutine: starts immediately and frees itself on return.
+struct Task {
+	struct promise_type {
+		Task get_return_object() {
+			return {};
+		}
+		std::suspend_never initial_suspend() noexcept {
+			return {};
+		}
+		std::suspend_never final_suspend() noexcept {
+			return {};
+		}
+		void return_void() {}
+		void unhandled_exception() {
+			std::terminate();
+		}
+	};
+};
+
+class Session;
+
+// A response slot registered as soon as its request is sent, so a pipelined
+// reply that lands before the coroutine gets around to awaiting it is kept.
+// Awaiting yields the response event; the awaiter owns its data1 afterwards.
+class PendingResponse {
+private:
+	Session& _session;
+	Uint64   _id;
+
+public:
+	PendingResponse(Session& session, Uint64 id);
+	PendingResponse(PendingResponse&)            = delete;
+	PendingResponse& operator=(PendingResponse&) = delete;
+	~PendingResponse();
+
+	bool          await_ready() const;
+	void          await_suspend(std::coroutine_handle<> waiter);
+	SDL_UserEvent await_resume();
+};
+
+// Lets request/response flows be written as straight-line coroutines. Replies
+// are delivered from the main thread's event dispatch, where the state the
+// flows touch lives; a request that times out resumes its waiter with an
+// UNKNOWN response.
+class Session {
+private:
+	friend class PendingResponse;
+
+	struct Slot {
+		std::coroutine_handle<> waiter;
+		SDL_UserEvent           response;
+		bool                    isReady;
+	};
+
+	std::unordered_map<Uint64, Slot> _slots;
+
+	void resolve(Uint64 id, const SDL_UserEvent& response);
+
+public:
+	Session();
+	Session(Session&)            = delete;
+	Session& operator=(Session&) = delete;
+	~Session();
+
+	void            cancel();
+	bool            deliver(const SDL_UserEvent& response);
+	PendingResponse expect(Uint64 id);
+	void            expire();
+};
+
+}  // namespace vts
+
+#endif  // VTS_SESSION_HPP_
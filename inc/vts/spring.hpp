@@ -0,0 +1,55 @@
+#ifndef VTS_SPRING_HPP_
+#define VTS_SPRING_HPP_
+
+#include <cstddef>
+#include <span>
+#include <vector>
+
+#include <SDL3/SDL_stdinc.h>
+
+namespace vts {
+
+struct SpringState {
+	float position = 0.0F;
+	float velocity = 0.0F;
+};
+
+class SpringBank {
+private:
+	std::vector<std::size_t> _owners;
+	std::vector<float>       _stiffnesses;
+	std::vector<float>       _dampings;
+	std::vector<float>       _positions;
+	std::vector<float>       _velocities;
+	std::vector<float>       _targets;
+
+	Uint64 _accumulatorNs;
+	Uint64 _lastTickNs;
+
+	void integrate(std::size_t steps);
+	void settle();
+
+public:
+	SpringBank();
+
+	[[nodiscard]] std::span<const std::size_t> owners() const;
+	[[nodiscard]] std::span<const float>       positions() const;
+	[[nodiscard]] std::span<float>             targets();
+
+	static void integrateSingle(SpringState& state,
+	                            float        frequency,
+	                            float        damping,
+	                            float        target,
+	                            std::size_t  steps);
+
+	void        add(std::size_t owner,
+	                float       frequency,
+	                float       damping,
+	                float       position);
+	void        clear();
+	std::size_t step(Uint64 nowNs);
+};
+
+}  // namespace vts
+
+#endif  // VTS_SPRING_HPP_
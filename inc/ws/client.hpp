@@ -1,32 +1,89 @@
 #ifndef WS_CLIENT_HPP_
 #define WS_CLIENT_HPP_
 
+#include <array>
 #include <atomic>
+#include <cstddef>
+#include <memory>
 #include <mutex>
-#include <queue>
 #include <string>
 #include <thread>
 
+#include <SDL3/SDL_stdinc.h>
 #include <mongoose.h>
 
+#include "core/bounded_queue.hpp"
+#include "vts/request_tracker.hpp"
 #include "ws/controller.hpp"
 
 namespace ws {
 
 class Client : public IController {
 private:
+	// A message owned by this connection, or one shared with the others.
+	struct Outgoing {
+		std::string                        owned;
+		std::shared_ptr<const std::string> shared;
+		Uint64                             queuedNs;
+		Uint64                             requestId;
+	};
+
+	static constexpr std::size_t SEND_QUEUE_CAPACITY = 256;
+	static constexpr std::size_t MAX_SPARE_BUFFERS   = 8;
+	static constexpr Uint8       FRESH_INJECTION     = 0x4;
+
+	using MessageQueue = core::BoundedQueue<Outgoing, SEND_QUEUE_CAPACITY>;
+
+	const std::size_t   _instance;
 	std::atomic<bool>   _alive;
 	std::atomic<Status> _status;
 	std::string         _url;
 	std::thread         _thread;
 
-	std::mutex              _sendMutex;
-	std::queue<std::string> _sendQueue;
+	// Senders on any thread push into a lane without locking and then wake the
+	// socket thread, which drains the lanes and hands emptied buffers back.
+	MessageQueue                                       _controlQueue;
+	MessageQueue                                       _bulkQueue;
+	core::BoundedQueue<std::string, MAX_SPARE_BUFFERS> _spareBuffers;
+	std::atomic<Uint64>                                _droppedMessages;
+
+	// The latest injection frame, triple-buffered: the sending thread fills
+	// the back slot and swaps it into the middle, flagged fresh; the socket
+	// thread swaps a fresh middle out to the front when it has room to send.
+	// Injections must all come from the same thread.
+	std::array<Outgoing, 3> _injections;
+	std::atomic<Uint8>      _injectionMiddle;
+	Uint8                   _injectionBack;
+	Uint8                   _injectionFront;
+	std::atomic<Uint64>     _droppedFrames;
+
+	// The manager is only set while the socket thread is polling it, and is
+	// not freed until every sender counted in _wakers has finished with it.
+	std::atomic<mg_mgr*>       _manager;
+	std::atomic<unsigned long> _connectionId;
+	std::atomic<Uint32>        _wakers;
+	std::atomic<bool>          _isWakeupPending;
+
+	std::mutex            _statsMutex;
+	vts::LatencyHistogram _queueLatency;
+
+	void      drainLane(mg_connection* connection,
+	                    MessageQueue&  queue,
+	                    std::size_t    budgetBytes);
+	void      flushInjection(mg_connection* connection);
+	void      flushLanes(mg_connection* connection);
+	void      logQueueLatency();
+	Uint64    publishInjection(Outgoing&& frame);
+	void      pushMessage(Outgoing&& outgoing, Lane lane);
+	void      recycle(Outgoing& outgoing);
+	Outgoing* takeInjection();
+	void      wake();
+	void      writeMessage(mg_connection* connection, Outgoing& outgoing);
 
 public:
-	Client();
+	explicit Client(std::size_t instance);
 	static void handleEvent(mg_connection* connection, int event, void* eventData);
-	static void handleMessage(mg_ws_message* message);
+	void        handleMessage(mg_ws_message* message);
 	void        handleError(const char* description);
 	void        handleOpen();
 	void        setStatus(Status newStatus);
@@ -34,11 +91,23 @@ public:
 
 	// IController
 	const char* getUrl() override;
+	std::size_t getInstance() override;
 	Status      getStatus() override;
-	void        sendMessage(std::string&& message) override;
+	std::string acquireBuffer() override;
+	void        sendMessage(std::string&& message, Lane lane) override;
 	void        setUrl(const char* url) override;
 	void        start() override;
 	void        stop() override;
+
+	void                  clearQueueLatency() override;
+	Uint64                getDroppedFrames() override;
+	vts::LatencyHistogram getQueueLatency() override;
+
+	bool   hasPendingInjection() override;
+	Uint64 sendInjection(Uint64 requestId, std::string&& message) override;
+	Uint64 sendSharedInjection(
+	    Uint64                             requestId,
+	    std::shared_ptr<const std::string> message) override;
 };
 
 }  // namespace ws
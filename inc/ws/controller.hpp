@@ -1,10 +1,14 @@
 #ifndef WS_CONTROLLER_HPP_
 #define WS_CONTROLLER_HPP_
 
+#include <cstddef>
+#include <memory>
 #include <string>
 
 #include <SDL3/SDL_stdinc.h>
 
+#include "vts/request_tracker.hpp"
+
 namespace ws {
 
 enum class Status : Uint8 {
@@ -14,16 +18,43 @@ enum class Status : Uint8 {
 	AUTHENTICATED,
 };
 
+// Outbound messages are written by priority: injection frames first, then
+// control messages, then bulk ones such as the plugin icon or parameter
+// creation, so a large request never holds up a frame.
+enum class Lane : Uint8 {
+	CONTROL,
+	BULK,
+};
+
 class IController {
 public:
 	virtual ~IController() = default;
 
-	virtual const char* getUrl()                           = 0;
-	virtual Status      getStatus()                        = 0;
-	virtual void        sendMessage(std::string&& message) = 0;
-	virtual void        setUrl(const char* url)            = 0;
-	virtual void        start()                            = 0;
-	virtual void        stop()                             = 0;
+	virtual const char* getUrl()                                      = 0;
+	virtual std::size_t getInstance()                                 = 0;
+	virtual Status      getStatus()                                   = 0;
+	virtual std::string acquireBuffer()                               = 0;
+	virtual void        sendMessage(std::string&& message, Lane lane) = 0;
+	virtual void        setUrl(const char* url)                       = 0;
+	virtual void        start()                                       = 0;
+	virtual void        stop()                                        = 0;
+
+	// Injection frames bypass the message lanes: each one replaces any frame
+	// still waiting to be sent, and the request id of the frame it replaced
+	// is returned (or 0) so the caller can stop waiting for its response.
+	// A pending frame may be taken at any moment, so a true answer from
+	// hasPendingInjection can be stale; a false one never is.
+	virtual bool   hasPendingInjection()                                  = 0;
+	virtual Uint64 sendInjection(Uint64 requestId, std::string&& message) = 0;
+	virtual Uint64 sendSharedInjection(
+	    Uint64                             requestId,
+	    std::shared_ptr<const std::string> message) = 0;
+
+	// Time messages spend queued before the socket thread writes them, and the
+	// number of injection frames replaced before they could be sent.
+	virtual void                  clearQueueLatency() = 0;
+	virtual Uint64                getDroppedFrames()  = 0;
+	virtual vts::LatencyHistogram getQueueLatency()   = 0;
 };
 
 };  // namespace ws
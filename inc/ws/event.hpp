@@ -1,6 +1,8 @@
 #ifndef WS_EVENT_HPP_
 #define WS_EVENT_HPP_
 
+#include <cstddef>
+
 #include <SDL3/SDL_events.h>
 #include <SDL3/SDL_stdinc.h>
 
@@ -11,8 +13,16 @@ enum Event : Uint32 {
 	MESSAGE = OPEN + 1,
 };
 
+// The connection configured at the settings' api_url; mirrors follow it.
+constexpr std::size_t PRIMARY_INSTANCE = 0;
+
 void allocateEvents();
 
+// Socket events carry the index of the connection that raised them in the
+// otherwise unused windowID field.
+std::size_t getInstance(const SDL_UserEvent& event);
+void        setInstance(SDL_UserEvent& event, std::size_t instance);
+
 }  // namespace ws
 
 #endif  // WS_EVENT_HPP_
@@ -0,0 +1,84 @@
+#include <csignal>
+#include <cstdlib>
+#include <string_view>
+
+#include <SDL3/SDL_log.h>
+
+#include "server.hpp"
+
+static constexpr int POLL_TIMEOUT_MS = 1;
+
+static volatile std::sig_atomic_t isRunning = 1;
+
+static void handleSignal(int) {
+	isRunning = 0;
+}
+
+static void printUsage(const char* program) {
+	SDL_Log(
+	    "Usage: %s [options]\n"
+	    "  --listen URL      address to accept on (default ws://0.0.0.0:8001)\n"
+	    "  --latency MS      delay before each reply\n"
+	    "  --jitter MS       extra random delay of up to MS\n"
+	    "  --error-rate P    answer a fraction P of requests with an APIError\n"
+	    "  --deny-token      refuse token requests\n"
+	    "  --token TOKEN     token to issue and accept (default mock-token)\n"
+	    "  --model-id ID     model id reported in parameter lists",
+	    program);
+}
+
+static bool parseArguments(int argc, char* argv[], mock::Config& config) {
+	for (int i = 1; i < argc; ++i) {
+		const std::string_view option = argv[i];
+		if (option == "--deny-token") {
+			config.denyToken = true;
+			continue;
+		}
+		if (i + 1 >= argc) {
+			return false;
+		}
+		const char* value = argv[++i];
+		if (option == "--listen") {
+			config.listenUrl = value;
+		}
+		else if (option == "--latency") {
+			config.latencyMs = std::strtoul(value, nullptr, 10);
+		}
+		else if (option == "--jitter") {
+			config.jitterMs = std::strtoul(value, nullptr, 10);
+		}
+		else if (option == "--error-rate") {
+			config.errorRate = std::strtof(value, nullptr);
+		}
+		else if (option == "--token") {
+			config.token = value;
+		}
+		else if (option == "--model-id") {
+			config.modelId = value;
+		}
+		else {
+			return false;
+		}
+	}
+	return true;
+}
+
+int main(int argc, char* argv[]) {
+	mock::Config config;
+	if (!parseArguments(argc, argv, config)) {
+		printUsage(argv[0]);
+		return 1;
+	}
+
+	std::signal(SIGINT, handleSignal);
+	std::signal(SIGTERM, handleSignal);
+
+	mock::Server server(config);
+	if (!server.listen()) {
+		return 1;
+	}
+	while (isRunning != 0) {
+		server.poll(POLL_TIMEOUT_MS);
+	}
+	return 0;
+}
@@ -0,0 +1,663 @@
+#include "server.hpp"
+
+#include <algorithm>
+#include <cstddef>
+#include <random>
+#include <span>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+#include <SDL3/SDL_log.h>
+#include <SDL3/SDL_stdinc.h>
+#include <glaze/core/common.hpp>
+#include <glaze/core/opts.hpp>
+#include <glaze/core/read.hpp>
+#include <glaze/json/read.hpp>
+#include <glaze/json/write.hpp>
+#include <mongoose.h>
+
+namespace mock {
+
+static constexpr glz::opts READ_OPTS{.null_terminated       = false,
+                                     .error_on_unknown_keys = false};
+
+static constexpr Uint64 REPORT_INTERVAL_MS = 1000;
+
+enum ErrorId : int {
+	INTERNAL_SERVER_ERROR   = 0,
+	REQUEST_TYPE_UNKNOWN    = 5,
+	REQUIRES_AUTHENTICATION = 8,
+	TOKEN_REQUEST_DENIED    = 50,
+	PARAMETER_NOT_FOUND     = 453,
+};
+
+struct Envelope {
+	std::string   requestId;
+	std::string   messageType;
+	glz::raw_json data;
+
+	struct glaze {
+		using T                     = Envelope;
+		static constexpr auto value = glz::object("requestID",
+		                                          &T::requestId,
+		                                          "messageType",
+		                                          &T::messageType,
+		                                          "data",
+		                                          &T::data);
+	};
+};
+
+template <typename DataType>
+struct Reply {
+	std::string_view apiName    = "VTubeStudioPublicAPI";
+	std::string_view apiVersion = "1.0";
+	Uint64           timestamp  = 0;
+	std::string_view requestId;
+	std::string_view messageType;
+	DataType         data;
+
+	struct glaze {
+		using T                     = Reply<DataType>;
+		static constexpr auto value = glz::object("apiName",
+		                                          &T::apiName,
+		                                          "apiVersion",
+		                                          &T::apiVersion,
+		                                          "timestamp",
+		                                          &T::timestamp,
+		                                          "requestID",
+		                                          &T::requestId,
+		                                          "messageType",
+		                                          &T::messageType,
+		                                          "data",
+		                                          &T::data);
+	};
+};
+
+template <typename DataType>
+static std::string makeReply(const std::string_view requestId,
+                             const std::string_view messageType,
+                             DataType               data) {
+	const Reply<DataType> reply{.timestamp   = mg_millis(),
+	                            .requestId   = requestId,
+	                            .messageType = messageType,
+	                            .data        = std::move(data)};
+	std::string message;
+	if (glz::write_json(reply, message)) {
+		SDL_LogError(SDL_LOG_CATEGORY_APPLICATION,
+		             "Failed to serialize %.*s",
+		             static_cast<int>(messageType.size()),
+		             messageType.data());
+		return {};
+	}
+	return message;
+}
+
+template <typename DataType>
+static bool readData(const std::string_view data, DataType& value) {
+	return !glz::read<READ_OPTS>(value, data.empty() ? "{}" : data);
+}
+
+struct ErrorData {
+	int         errorId;
+	std::string message;
+
+	struct glaze {
+		using T = ErrorData;
+		static constexpr auto value =
+		    glz::object("errorID", &T::errorId, "message", &T::message);
+	};
+};
+
+static std::string makeError(const std::string_view requestId,
+                             const ErrorId          errorId,
+                             std::string            message) {
+	return makeReply(
+	    requestId,
+	    "APIError",
+	    ErrorData{.errorId = errorId, .message = std::move(message)});
+}
+
+struct EmptyData {
+	struct glaze {
+		static constexpr auto value = glz::object();
+	};
+};
+
+struct ApiStateData {
+	bool             active                      = true;
+	std::string_view vTubeStudioVersion          = "mock";
+	bool             currentSessionAuthenticated = false;
+
+	struct glaze {
+		using T                     = ApiStateData;
+		static constexpr auto value = glz::object("active",
+		                                          &T::active,
+		                                          "vTubeStudioVersion",
+		                                          &T::vTubeStudioVersion,
+		                                          "currentSessionAuthenticated",
+		                                          &T::currentSessionAuthenticated);
+	};
+};
+
+struct PluginData {
+	std::string pluginName;
+	std::string pluginDeveloper;
+	std::string authenticationToken;
+
+	struct glaze {
+		using T                     = PluginData;
+		static constexpr auto value = glz::object("pluginName",
+		                                          &T::pluginName,
+		                                          "pluginDeveloper",
+		                                          &T::pluginDeveloper,
+		                                          "authenticationToken",
+		                                          &T::authenticationToken);
+	};
+};
+
+struct TokenData {
+	std::string_view authenticationToken;
+
+	struct glaze {
+		using T = TokenData;
+		static constexpr auto value =
+		    glz::object("authenticationToken", &T::authenticationToken);
+	};
+};
+
+struct AuthenticationData {
+	bool             authenticated;
+	std::string_view reason;
+
+	struct glaze {
+		using T = AuthenticationData;
+		static constexpr auto value =
+		    glz::object("authenticated", &T::authenticated, "reason", &T::reason);
+	};
+};
+
+struct ParameterData {
+	std::string name;
+	std::string addedBy;
+	float       value;
+	float       min;
+	float       max;
+	float       defaultValue;
+
+	struct glaze {
+		using T                     = ParameterData;
+		static constexpr auto value = glz::object("name",
+		                                          &T::name,
+		                                          "addedBy",
+		                                          &T::addedBy,
+		                                          "value",
+		                                          &T::value,
+		                                          "min",
+		                                          &T::min,
+		                                          "max",
+		                                          &T::max,
+		                                          "defaultValue",
+		                                          &T::defaultValue);
+	};
+};
+
+struct ParameterListData {
+	bool                       modelLoaded = true;
+	std::string_view           modelName;
+	std::string_view           modelId;
+	std::vector<ParameterData> customParameters;
+	std::vector<ParameterData> defaultParameters;
+
+	struct glaze {
+		using T                     = ParameterListData;
+		static constexpr auto value = glz::object("modelLoaded",
+		                                          &T::modelLoaded,
+		                                          "modelName",
+		                                          &T::modelName,
+		                                          "modelID",
+		                                          &T::modelId,
+		                                          "customParameters",
+		                                          &T::customParameters,
+		                                          "defaultParameters",
+		                                          &T::defaultParameters);
+	};
+};
+
+struct ParameterCreationData {
+	std::string parameterName;
+	float       min          = 0.0F;
+	float       max          = 1.0F;
+	float       defaultValue = 0.0F;
+
+	struct glaze {
+		using T                     = ParameterCreationData;
+		static constexpr auto value = glz::object("parameterName",
+		                                          &T::parameterName,
+		                                          "min",
+		                                          &T::min,
+		                                          "max",
+		                                          &T::max,
+		                                          "defaultValue",
+		                                          &T::defaultValue);
+	};
+};
+
+struct ParameterNameData {
+	std::string parameterName;
+
+	struct glaze {
+		using T = ParameterNameData;
+		static constexpr auto value =
+		    glz::object("parameterName", &T::parameterName);
+	};
+};
+
+struct InjectedValue {
+	std::string id;
+	float       value = 0.0F;
+
+	struct glaze {
+		using T                     = InjectedValue;
+		static constexpr auto value = glz::object("id", &T::id, "value", &T::value);
+	};
+};
+
+struct InjectionData {
+	std::vector<InjectedValue> parameterValues;
+
+	struct glaze {
+		using T = InjectionData;
+		static constexpr auto value =
+		    glz::object("parameterValues", &T::parameterValues);
+	};
+};
+
+struct SubscriptionRequestData {
+	std::string eventName;
+	bool        subscribe = true;
+
+	struct glaze {
+		using T                     = SubscriptionRequestData;
+		static constexpr auto value = glz::object("eventName",
+		                                          &T::eventName,
+		                                          "subscribe",
+		                                          &T::subscribe);
+	};
+};
+
+struct SubscriptionData {
+	std::size_t                  subscribedEventCount;
+	std::span<const std::string> subscribedEvents;
+
+	struct glaze {
+		using T                     = SubscriptionData;
+		static constexpr auto value = glz::object("subscribedEventCount",
+		                                          &T::subscribedEventCount,
+		                                          "subscribedEvents",
+		                                          &T::subscribedEvents);
+	};
+};
+
+// The mock loads no items, so the list is always empty.
+struct ItemListData {
+	std::size_t                itemsInSceneCount    = 0;
+	bool                       canLoadItemsRightNow = true;
+	std::span<const EmptyData> itemInstancesInScene;
+
+	struct glaze {
+		using T                     = ItemListData;
+		static constexpr auto value = glz::object("itemsInSceneCount",
+		                                          &T::itemsInSceneCount,
+		                                          "canLoadItemsRightNow",
+		                                          &T::canLoadItemsRightNow,
+		                                          "itemInstancesInScene",
+		                                          &T::itemInstancesInScene);
+	};
+};
+
+struct ItemToMove {
+	std::string itemInstanceId;
+
+	struct glaze {
+		using T = ItemToMove;
+		static constexpr auto value =
+		    glz::object("itemInstanceID", &T::itemInstanceId);
+	};
+};
+
+struct ItemMoveRequestData {
+	std::vector<ItemToMove> itemsToMove;
+
+	struct glaze {
+		using T = ItemMoveRequestData;
+		static constexpr auto value =
+		    glz::object("itemsToMove", &T::itemsToMove);
+	};
+};
+
+struct MovedItem {
+	std::string itemInstanceId;
+	bool        success = true;
+	int         errorId = -1;
+
+	struct glaze {
+		using T                     = MovedItem;
+		static constexpr auto value = glz::object("itemInstanceID",
+		                                          &T::itemInstanceId,
+		                                          "success",
+		                                          &T::success,
+		                                          "errorID",
+		                                          &T::errorId);
+	};
+};
+
+struct ItemMoveData {
+	std::vector<MovedItem> movedItems;
+
+	struct glaze {
+		using T = ItemMoveData;
+		static constexpr auto value = glz::object("movedItems", &T::movedItems);
+	};
+};
+
+Server::Server(Config config) :
+    _config(std::move(config)),
+    _manager(),
+    _clients(),
+    _parameters(),
+    _replies(),
+    _random(std::random_device{}()),
+    _windowStartMs(0),
+    _injections(0),
+    _injectedValues(0) {
+	mg_mgr_init(&_manager);
+}
+
+Server::~Server() {
+	mg_mgr_free(&_manager);
+}
+
+void Server::handleEvent(mg_connection* connection,
+                         int            event,
+                         void*          eventData) {
+	auto* server = static_cast<Server*>(connection->fn_data);
+	switch (event) {
+		case MG_EV_HTTP_MSG:
+			mg_ws_upgrade(connection,
+			              static_cast<mg_http_message*>(eventData),
+			              nullptr);
+			break;
+		case MG_EV_WS_OPEN:
+			server->_clients[connection->id] = Client();
+			SDL_Log("Client %lu connected", connection->id);
+			break;
+		case MG_EV_WS_MSG: {
+			const auto* message = static_cast<mg_ws_message*>(eventData);
+			server->handleMessage(connection,
+			                      {message->data.buf, message->data.len});
+			break;
+		}
+		case MG_EV_CLOSE:
+			if (server->_clients.erase(connection->id) > 0) {
+				SDL_Log("Client %lu disconnected", connection->id);
+			}
+			break;
+	}
+}
+
+CustomParameter* Server::findParameter(const std::string_view name) {
+	const auto it = std::ranges::find(_parameters, name, &CustomParameter::name);
+	return it == _parameters.end() ? nullptr : &*it;
+}
+
+mg_connection* Server::findConnection(const unsigned long id) {
+	for (auto* connection = _manager.conns; connection != nullptr;
+	     connection       = connection->next) {
+		if (connection->id == id) {
+			return connection;
+		}
+	}
+	return nullptr;
+}
+
+bool Server::shouldFail() {
+	if (_config.errorRate <= 0.0F) {
+		return false;
+	}
+	return std::bernoulli_distribution(_config.errorRate)(_random);
+}
+
+Uint64 Server::getDelayMs() {
+	if (_config.jitterMs == 0) {
+		return _config.latencyMs;
+	}
+	std::uniform_int_distribution<Uint32> jitter(0, _config.jitterMs);
+	return _config.latencyMs + jitter(_random);
+}
+
+std::string Server::handleRequest(Client&                client,
+                                  const std::string_view requestId,
+                                  const std::string_view messageType,
+                                  const std::string_view data) {
+	if (messageType == "APIStateRequest") {
+		return makeReply(
+		    requestId,
+		    "APIStateResponse",
+		    ApiStateData{.currentSessionAuthenticated = client.isAuthenticated});
+	}
+	if (messageType == "AuthenticationTokenRequest") {
+		if (_config.denyToken) {
+			return makeError(requestId,
+			                 TOKEN_REQUEST_DENIED,
+			                 "The user has denied API access for your plugin.");
+		}
+		return makeReply(requestId,
+		                 "AuthenticationTokenResponse",
+		                 TokenData{.authenticationToken = _config.token});
+	}
+	if (messageType == "AuthenticationRequest") {
+		PluginData plugin;
+		readData(data, plugin);
+		client.isAuthenticated = plugin.authenticationToken == _config.token;
+		client.pluginName      = plugin.pluginName;
+		return makeReply(requestId,
+		                 "AuthenticationResponse",
+		                 AuthenticationData{
+		                     .authenticated = client.isAuthenticated,
+		                     .reason        = client.isAuthenticated
+		                                          ? "Token valid."
+		                                          : "Token invalid.",
+		                 });
+	}
+	if (!client.isAuthenticated) {
+		return makeError(requestId,
+		                 REQUIRES_AUTHENTICATION,
+		                 "This request requires authentication.");
+	}
+
+	if (messageType == "InputParameterListRequest") {
+		ParameterListData list{.modelName         = _config.modelName,
+		                       .modelId           = _config.modelId,
+		                       .customParameters  = {},
+		                       .defaultParameters = {}};
+		for (const auto& parameter : _parameters) {
+			list.customParameters.push_back({
+			    .name         = parameter.name,
+			    .addedBy      = parameter.addedBy,
+			    .value        = parameter.value,
+			    .min          = parameter.min,
+			    .max          = parameter.max,
+			    .defaultValue = parameter.defaultValue,
+			});
+		}
+		return makeReply(requestId, "InputParameterListResponse", list);
+	}
+	if (messageType == "ParameterCreationRequest") {
+		ParameterCreationData request;
+		if (!readData(data, request) || request.parameterName.empty()) {
+			return makeError(requestId,
+			                 INTERNAL_SERVER_ERROR,
+			                 "Malformed parameter creation request.");
+		}
+		auto* parameter = findParameter(request.parameterName);
+		if (parameter == nullptr) {
+			parameter       = &_parameters.emplace_back();
+			parameter->name = request.parameterName;
+		}
+		parameter->addedBy      = client.pluginName;
+		parameter->min          = request.min;
+		parameter->max          = request.max;
+		parameter->defaultValue = request.defaultValue;
+		parameter->value        = request.defaultValue;
+		return makeReply(
+		    requestId,
+		    "ParameterCreationResponse",
+		    ParameterNameData{.parameterName = request.parameterName});
+	}
+	if (messageType == "ParameterDeletionRequest") {
+		ParameterNameData request;
+		readData(data, request);
+		if (std::erase_if(_parameters, [&request](const CustomParameter& p) {
+			    return p.name == request.parameterName;
+		    })
+		    == 0) {
+			return makeError(requestId,
+			                 PARAMETER_NOT_FOUND,
+			                 "Parameter not found: " + request.parameterName);
+		}
+		return makeReply(requestId, "ParameterDeletionResponse", request);
+	}
+	if (messageType == "InjectParameterDataRequest") {
+		InjectionData request;
+		readData(data, request);
+		for (const auto& value : request.parameterValues) {
+			auto* parameter = findParameter(value.id);
+			if (parameter == nullptr) {
+				return makeError(requestId,
+				                 PARAMETER_NOT_FOUND,
+				                 "Parameter not found: " + value.id);
+			}
+			parameter->value = value.value;
+		}
+		++_injections;
+		_injectedValues += request.parameterValues.size();
+		return makeReply(requestId, "InjectParameterDataResponse", EmptyData());
+	}
+	if (messageType == "EventSubscriptionRequest") {
+		SubscriptionRequestData request;
+		readData(data, request);
+		std::erase(client.subscriptions, request.eventName);
+		if (request.subscribe) {
+			client.subscriptions.push_back(request.eventName);
+		}
+		return makeReply(requestId,
+		                 "EventSubscriptionResponse",
+		                 SubscriptionData{
+		                     .subscribedEventCount = client.subscriptions.size(),
+		                     .subscribedEvents     = client.subscriptions,
+		                 });
+	}
+	if (messageType == "ItemListRequest") {
+		return makeReply(requestId, "ItemListResponse", ItemListData());
+	}
+	// Every move is reported as applied, whichever instance it names.
+	if (messageType == "ItemMoveRequest") {
+		ItemMoveRequestData request;
+		readData(data, request);
+		ItemMoveData moved;
+		moved.movedItems.reserve(request.itemsToMove.size());
+		for (auto& item : request.itemsToMove) {
+			moved.movedItems.push_back(
+			    {.itemInstanceId = std::move(item.itemInstanceId)});
+		}
+		return makeReply(requestId, "ItemMoveResponse", std::move(moved));
+	}
+	return makeError(requestId,
+	                 REQUEST_TYPE_UNKNOWN,
+	                 "Unsupported request: " + std::string(messageType));
+}
+
+// Replies to one client leave in the order its requests arrived, as they do
+// from VTS, however the jitter falls.
+void Server::handleMessage(mg_connection*         connection,
+                           const std::string_view json) {
+	auto& client = _clients[connection->id];
+
+	Envelope envelope;
+	if (glz::read<READ_OPTS>(envelope, json)) {
+		SDL_LogWarn(SDL_LOG_CATEGORY_APPLICATION, "Ignoring malformed frame");
+		return;
+	}
+	const std::string_view requestId = envelope.requestId;
+
+	std::string reply =
+	    shouldFail()
+	        ? makeError(requestId, INTERNAL_SERVER_ERROR, "Injected failure.")
+	        : handleRequest(client,
+	                        requestId,
+	                        envelope.messageType,
+	                        envelope.data.str);
+	if (reply.empty()) {
+		return;
+	}
+
+	const Uint64 dueMs = std::max(mg_millis() + getDelayMs(), client.lastDueMs);
+	client.lastDueMs   = dueMs;
+	_replies.emplace(dueMs,
+	                 PendingReply{.connection = connection->id,
+	                              .message    = std::move(reply)});
+}
+
+void Server::flushReplies(const Uint64 nowMs) {
+	while (!_replies.empty() && _replies.begin()->first <= nowMs) {
+		const auto& reply      = _replies.begin()->second;
+		auto*       connection = findConnection(reply.connection);
+		if (connection != nullptr) {
+			mg_ws_send(connection,
+			           reply.message.data(),
+			           reply.message.size(),
+			           WEBSOCKET_OP_TEXT);
+		}
+		_replies.erase(_replies.begin());
+	}
+}
+
+void Server::reportThroughput(const Uint64 nowMs) {
+	const Uint64 elapsedMs = nowMs - _windowStartMs;
+	if (elapsedMs < REPORT_INTERVAL_MS) {
+		return;
+	}
+	if (_injections > 0) {
+		const double seconds = static_cast<double>(elapsedMs) / 1000.0;
+		SDL_Log("%.1f injections/s, %.1f values/s",
+		        static_cast<double>(_injections) / seconds,
+		        static_cast<double>(_injectedValues) / seconds);
+	}
+	_windowStartMs  = nowMs;
+	_injections     = 0;
+	_injectedValues = 0;
+}
+
+bool Server::listen() {
+	if (mg_http_listen(&_manager, _config.listenUrl.c_str(), handleEvent, this)
+	    == nullptr) {
+		SDL_LogError(SDL_LOG_CATEGORY_APPLICATION,
+		             "Failed to listen on %s",
+		             _config.listenUrl.c_str());
+		return false;
+	}
+	SDL_Log("Mock VTube Studio listening on %s", _config.listenUrl.c_str());
+	_windowStartMs = mg_millis();
+	return true;
+}
+
+void Server::poll(const int timeoutMs) {
+	mg_mgr_poll(&_manager, timeoutMs);
+	const Uint64 nowMs = mg_millis();
+	flushReplies(nowMs);
+	reportThroughput(nowMs);
+}
+
+}  // namespace mock
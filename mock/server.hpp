@@ -0,0 +1,94 @@
+#ifndef MOCK_SERVER_HPP_
+#define MOCK_SERVER_HPP_
+
+#include <map>
+#include <random>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+#include <SDL3/SDL_stdinc.h>
+#include <mongoose.h>
+
+namespace mock {
+
+struct Config {
+	std::string listenUrl = "ws://0.0.0.0:8001";
+	std::string token     = "mock-token";
+	std::string modelId   = "mock-model";
+	std::string modelName = "Mock";
+	Uint32      latencyMs = 0;
+	Uint32      jitterMs  = 0;
+	float       errorRate = 0.0F;
+	bool        denyToken = false;
+};
+
+struct CustomParameter {
+	std::string name;
+	std::string addedBy;
+	float       value        = 0.0F;
+	float       min          = 0.0F;
+	float       max          = 1.0F;
+	float       defaultValue = 0.0F;
+};
+
+// Stands in for the VTube Studio API on a headless machine. It speaks enough
+// of the protocol for the relay's handshake, parameter management,
+// injection and item moves, can delay and fail replies on demand, and logs
+// injection throughput once a second.
+class Server {
+private:
+	struct Client {
+		bool                     isAuthenticated = false;
+		std::string              pluginName;
+		std::vector<std::string> subscriptions;
+		Uint64                   lastDueMs = 0;
+	};
+
+	struct PendingReply {
+		unsigned long connection;
+		std::string   message;
+	};
+
+	Config                                    _config;
+	mg_mgr                                    _manager;
+	std::unordered_map<unsigned long, Client> _clients;
+	std::vector<CustomParameter>              _parameters;
+	std::multimap<Uint64, PendingReply>       _replies;
+	std::mt19937                              _random;
+
+	Uint64 _windowStartMs;
+	Uint64 _injections;
+	Uint64 _injectedValues;
+
+	static void handleEvent(mg_connection* connection,
+	                        int            event,
+	                        void*          eventData);
+
+	CustomParameter* findParameter(std::string_view name);
+	mg_connection*   findConnection(unsigned long id);
+	bool             shouldFail();
+	Uint64           getDelayMs();
+
+	std::string handleRequest(Client&          client,
+	                          std::string_view requestId,
+	                          std::string_view messageType,
+	                          std::string_view data);
+	void        handleMessage(mg_connection* connection, std::string_view json);
+	void        flushReplies(Uint64 nowMs);
+	void        reportThroughput(Uint64 nowMs);
+
+public:
+	explicit Server(Config config);
+	Server(Server&)            = delete;
+	Server& operator=(Server&) = delete;
+	~Server();
+
+	bool listen();
+	void poll(int timeoutMs);
+};
+
+}  // namespace mock
+
+#endif  // MOCK_SERVER_HPP_
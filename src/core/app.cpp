@@ -1,11 +1,17 @@
 #include "core/app.hpp"
 
+#include <algorithm>
+#include <deque>
+#include <memory>
 #include <string>
+#include <string_view>
 #include <vector>
 
 #include <SDL3/SDL_events.h>
 #include <SDL3/SDL_gpu.h>
 #include <SDL3/SDL_init.h>
+#include <SDL3/SDL_log.h>
+#include <SDL3/SDL_timer.h>
 #include <SDL3/SDL_tray.h>
 
 #include "imgui/backends/imgui_impl_sdl3.h"
@@ -18,26 +24,48 @@
 #include "gui/theme.hpp"
 #include "mnk/event.hpp"
 #include "vts/request.hpp"
+#include "vts/request_tracker.hpp"
 #include "vts/response.hpp"
 #include "ws/event.hpp"
 
 namespace core {
 
+// How often the parameter list is re-requested when VTS won't push model
+// events, so model switches are still picked up.
+static constexpr Uint64 MODEL_POLL_INTERVAL_NS = SDL_MS_TO_NS(5000);
+
 App::App() :
     _alive(true),
+    _isModelLoaded(true),
+    _isPollingModel(false),
+    _nextModelPollNs(0),
     _pacer(),
     _gpu(nullptr),
     _parameters(),
     _impulseProcessor(),
-    _wsClient(),
+    _injectionEncoder(SETTINGS.getInjectionPrecision()),
+    _payload(),
+    _listRefresh(),
+    _models(),
+    _items(),
+    _itemMoveId(0),
+    _wsClient(ws::PRIMARY_INSTANCE),
+    _session(),
     _mnkMonitor(),
     _gamepadManager(),
+    _mirrors(),
+    _mirrorPayload(),
+    _recipients(),
     _config(_gamepadManager, _impulseProcessor, _wsClient, _parameters),
     _icon() {
 	ws::allocateEvents();
 	mnk::allocateEvents();
 	gui::allocateEvents();
+	loadItemSettings();
 	_wsClient.start();
+	for (std::size_t i = 1; i < SETTINGS.getInstanceCount(); ++i) {
+		_mirrors.push_back(std::make_unique<vts::Mirror>(i));
+	}
 }
 
 App::~App() {
@@ -77,6 +105,7 @@ void App::quit() {
 	_config.close(_gpu);
 	stopMouseKeyboard();
 	stopWs();
+	_mirrors.clear();
 	_alive = false;
 }
 
@@ -107,9 +136,23 @@ void App::run() {
 		_impulseProcessor.update();
 		for (const auto& [code, value] : _impulseProcessor.impulses()) {
 			_parameters.distributeImpulse(code, value);
+			_items.distributeImpulse(code, value);
 		}
+		_parameters.simulate(SDL_GetTicksNS());
+		_parameters.propagate();
 		checkParameterValues();
+		checkItemMoves();
 		_impulseProcessor.clear();
+		REQUESTS.expire(SDL_GetTicksNS());
+		_session.expire();
+		for (auto& mirror : _mirrors) {
+			mirror->expire();
+			mirror->checkReconnect(SDL_GetTicksNS());
+		}
+		checkModelPoll();
+		if (_listRefresh.poll(SDL_GetTicksNS())) {
+			_listRefresh.setRequest(vts::getParameters(_wsClient));
+		}
 
 		_pacer.endFrame();
 	}
@@ -136,7 +179,15 @@ void App::handleEvent(SDL_Event& event) {
 			_impulseProcessor.handleEvent(event.user);
 			break;
 		case ws::Event::OPEN:
-			vts::authenticate(_wsClient);
+			if (ws::getInstance(event.user) != ws::PRIMARY_INSTANCE) {
+				if (auto* mirror = findMirror(ws::getInstance(event.user))) {
+					mirror->handleOpen();
+				}
+				break;
+			}
+			_session.cancel();
+			REQUESTS.clearInFlight(ws::PRIMARY_INSTANCE);
+			startSession();
 			break;
 		case ws::Event::MESSAGE:
 			handleVtsMessage(event.user);
@@ -144,6 +195,10 @@ void App::handleEvent(SDL_Event& event) {
 		case gui::Event::THEME_HUE_CHANGE:
 			handleThemeHueChange(event.user);
 			break;
+		case gui::Event::PARAMETER_BATCH:
+			applyParameterBatch(std::unique_ptr<vts::ParameterBatch>(
+			    static_cast<vts::ParameterBatch*>(event.user.data1)));
+			break;
 		case SDL_EVENT_QUIT:
 			quit();
 			break;
@@ -177,88 +232,384 @@ void App::handleVtsApiError() {
 	stopWs();
 }
 
-void App::handleVtsAuthenticationToken(SDL_UserEvent& event) {
-	auto* token = static_cast<std::string*>(event.data1);
-	SETTINGS.setAuthToken(token->c_str());
-	vts::authenticate(_wsClient);
-	delete token;
+void App::handleVtsInputParameterList(SDL_UserEvent& event) {
+	const auto* list = static_cast<vts::ParameterList*>(event.data1);
+	_isModelLoaded   = list->modelLoaded;
+	_models.store(*list);
+	applyParameterNames(vts::getNames(list->parameters));
+	pruneParameterSettings();
+	vts::releaseResponse(event);
 }
 
-void App::handleVtsAuthenticationSuccess() {
-	_wsClient.setStatus(ws::Status::AUTHENTICATED);
-	vts::getParameters(_wsClient);
+void App::applyParameterNames(const std::vector<std::string>& names) {
+	const auto added = _parameters.sync(names);
+	if (!added.empty()) {
+		loadParameterSettings(added);
+	}
 }
 
-void App::handleVtsAuthenticationFailure() {
-	SETTINGS.setAuthToken("");
-	stopWs();
+// Custom parameters are shared by every model, so a cached list may predate
+// ones created since. Settings are only pruned against a live list.
+void App::pruneParameterSettings() {
+	for (const auto& settingsParameter : SETTINGS.getParameters()) {
+		if (_parameters.find(settingsParameter.name) == nullptr) {
+			SETTINGS.removeParameter(settingsParameter.name);
+		}
+	}
 }
 
-void App::handleVtsInputParameterList(SDL_UserEvent& event) {
-	auto* names = static_cast<std::vector<std::string>*>(event.data1);
-	_parameters.clear();
-	for (const auto& name : *names) {
-		_parameters.add(name);
+// Saving an edit re-creates the parameter under its current name, so an
+// existing one is rebuilt from its new settings. Only unknown names need the
+// list refreshed.
+void App::handleVtsParameterCreation(SDL_UserEvent& event) {
+	const auto* name = static_cast<std::string*>(event.data1);
+	if (_parameters.reset(*name) != nullptr) {
+		loadParameterSettings({*name});
+	}
+	else {
+		refreshParameterList();
+	}
+	vts::releaseResponse(event);
+}
+
+// VTS pushes this on every load and unload. Injection pauses while no model
+// is loaded, since values sent then would be applied to nothing; a newly
+// loaded model is warm-started from the cache and then confirmed by a list
+// refresh.
+void App::handleVtsModelLoaded(SDL_UserEvent& event) {
+	const auto* status = static_cast<vts::ModelStatus*>(event.data1);
+	_isModelLoaded     = status->modelLoaded;
+	if (_isModelLoaded) {
+		const auto* model = _models.find(status->modelId);
+		if (model != nullptr) {
+			applyParameterNames(vts::getNames(model->parameters));
+		}
+		_listRefresh.flush(SDL_GetTicksNS());
 	}
-	delete names;
-	loadParameterSettings();
+	vts::releaseResponse(event);
 }
 
-void App::handleVtsParameterCreation() {
-	vts::getParameters(_wsClient);
+void App::handleVtsItemEvent(SDL_UserEvent& event) {
+	switch (event.code) {
+		case vts::ResponseCode::ITEM_LIST:
+			_items.bindAll(
+			    *static_cast<std::vector<vts::ItemInstance>*>(event.data1));
+			break;
+		case vts::ResponseCode::ITEM_ADDED:
+			_items.bind(*static_cast<vts::ItemInstance*>(event.data1));
+			break;
+		case vts::ResponseCode::ITEM_REMOVED:
+			_items.unbind(static_cast<vts::ItemInstance*>(event.data1)->instanceId);
+			break;
+	}
+	vts::releaseResponse(event);
 }
 
 void App::handleVtsParameterDeletion() {
-	vts::getParameters(_wsClient);
+	refreshParameterList();
 }
 
+void App::refreshParameterList() {
+	_listRefresh.schedule(SDL_GetTicksNS());
+}
+
+// Mirrors that have every pending parameter are sent the same message as the
+// primary instance; the rest get one limited to what they have. Values left
+// pending while no instance is authenticated with a model loaded stay dirty
+// and are sent once one is, since draining them also marks them as sent.
+//
+// A frame only carries the values that changed, so one that would replace a
+// frame still waiting to be sent is rendered from every live value instead;
+// whatever the old frame held is then carried into the new one.
 void App::checkParameterValues() {
-	std::vector<vts::ParameterValue> payload;
-	for (auto& parameter : _parameters.values()) {
-		if (parameter.isFresh()) {
-			payload.emplace_back(parameter.getName(), parameter.getOutput());
+	const bool isPrimaryReady =
+	    _isModelLoaded && _wsClient.getStatus() == ws::Status::AUTHENTICATED;
+	const bool isMirrorReady = std::ranges::any_of(
+	    _mirrors,
+	    [](const auto& mirror) { return mirror->isReady(); });
+	if (!isPrimaryReady && !isMirrorReady) {
+		return;
+	}
+	const bool isFramePending =
+	    (isPrimaryReady && _wsClient.hasPendingInjection())
+	    || std::ranges::any_of(_mirrors, [](const auto& mirror) {
+		       return mirror->isReady()
+		              && mirror->getClient().hasPendingInjection();
+	       });
+	if (isFramePending) {
+		_parameters.markAllChanged();
+	}
+	_payload.clear();
+	_parameters.collectPending(
+	    SDL_GetTicksNS(),
+	    [this](const std::string_view name, const vts::Parameter& parameter) {
+		    _payload.push_back({.id = name, .value = parameter.getOutput()});
+	    });
+	if (_payload.empty()) {
+		return;
+	}
+
+	_recipients.clear();
+	if (isPrimaryReady) {
+		_recipients.push_back(&_wsClient);
+	}
+	for (auto& mirror : _mirrors) {
+		if (!mirror->isReady()) {
+			continue;
+		}
+		if (mirror->covers(_payload)) {
+			_recipients.push_back(&mirror->getClient());
+			continue;
+		}
+		mirror->filter(_payload, _mirrorPayload);
+		if (!_mirrorPayload.empty()) {
+			vts::setParameters(mirror->getClient(),
+			                   _injectionEncoder,
+			                   _mirrorPayload);
 		}
 	}
-	if (!payload.empty()) {
-		vts::setParameters(_wsClient, payload);
+	vts::setParameters(_recipients, _injectionEncoder, _payload);
+}
+
+void App::checkModelPoll() {
+	const Uint64 nowNs = SDL_GetTicksNS();
+	if (!_isPollingModel
+	    || nowNs < _nextModelPollNs
+	    || _wsClient.getStatus() != ws::Status::AUTHENTICATED) {
+		return;
 	}
+	_nextModelPollNs = nowNs + MODEL_POLL_INTERVAL_NS;
+	refreshParameterList();
 }
 
-void App::loadParameterSettings() {
-	auto settingsParameters = SETTINGS.getParameters();
-	for (const auto& settingsParameter : settingsParameters) {
-		auto it = _parameters.find(settingsParameter.name);
-		if (it == _parameters.end()) {
-			SETTINGS.removeParameter(settingsParameter.name);
-		}
-		else {
-			it->second.setBlendMode(settingsParameter.blendMode);
-			for (const auto& receiver : settingsParameter.receivers) {
-				it->second.addImpulse(receiver.code, receiver.isInverted);
+// Item changes wait in the manager until the connection can take them. Only
+// one move is in flight at a time: until it is answered, further changes
+// pile up per item and channel, so the next request carries just the latest
+// value of each instead of queueing one stale move per frame.
+void App::checkItemMoves() {
+	if (_items.isEmpty()
+	    || _wsClient.getStatus() != ws::Status::AUTHENTICATED
+	    || REQUESTS.isInFlight(_itemMoveId)) {
+		return;
+	}
+	const auto moves = _items.collectMoves();
+	if (!moves.empty()) {
+		_itemMoveId = vts::moveItems(_wsClient, moves);
+	}
+}
+
+void App::loadItemSettings() {
+	using enum vts::ItemChannel;
+
+	_items.clear();
+	for (const auto& settingsItem : SETTINGS.getItems()) {
+		auto&      item = _items.add(settingsItem.fileName);
+		const auto load = [&item](const vts::ItemChannel channel,
+		                          const auto&            settingsChannel) {
+			if (!settingsChannel) {
+				return;
+			}
+			auto& parameter = item.getChannel(channel);
+			parameter.setBlendMode(settingsChannel->blendMode);
+			parameter.setEpsilon(settingsChannel->epsilon);
+			parameter.setQuantization(settingsChannel->quantization);
+			for (const auto& receiver : settingsChannel->receivers) {
+				parameter.addImpulse(receiver.code, receiver.isInverted);
 			}
+			item.setRange(channel,
+			              {.low  = settingsChannel->low,
+			               .high = settingsChannel->high});
+		};
+		load(POSITION_X, settingsItem.positionX);
+		load(POSITION_Y, settingsItem.positionY);
+		load(ROTATION, settingsItem.rotation);
+		load(SIZE, settingsItem.size);
+	}
+}
+
+vts::Mirror* App::findMirror(const std::size_t instance) {
+	if (instance == ws::PRIMARY_INSTANCE || instance > _mirrors.size()) {
+		return nullptr;
+	}
+	return _mirrors[instance - 1].get();
+}
+
+void App::loadParameterSettings(const std::vector<std::string>& names) {
+	for (const auto& settingsParameter : SETTINGS.getParameters()) {
+		if (std::ranges::find(names, settingsParameter.name) == names.end()) {
+			continue;
+		}
+		auto* parameter = _parameters.find(settingsParameter.name);
+		if (parameter == nullptr) {
+			continue;
+		}
+		parameter->setBlendMode(settingsParameter.blendMode);
+		parameter->setEpsilon(settingsParameter.epsilon);
+		parameter->setQuantization(settingsParameter.quantization);
+		parameter->setSpring(settingsParameter.springFrequency,
+		                     settingsParameter.springDamping);
+		for (const auto& receiver : settingsParameter.receivers) {
+			parameter->addImpulse(receiver.code, receiver.isInverted);
+		}
+		for (const auto& link : settingsParameter.links) {
+			parameter->addLink(link.source, link.weight);
+		}
+		const auto error = parameter->setExpression(settingsParameter.expression);
+		if (error) {
+			SDL_Log("Invalid expression for %s: %s",
+			        settingsParameter.name.c_str(),
+			        error->message.c_str());
+		}
+	}
+	_parameters.rebuildGraph();
+	_parameters.rebuildSprings();
+}
+
+// Every request is sent before the first await, so the batch costs one round
+// trip. Parameters that already existed are rebuilt from their new settings,
+// and the list is refreshed once after the last response.
+vts::Task App::applyParameterBatch(
+    std::unique_ptr<vts::ParameterBatch> batch) {
+	std::deque<vts::PendingResponse> responses;
+	for (const Uint64 id : batch->send(_wsClient)) {
+		if (id != 0) {
+			responses.emplace_back(_session, id);
+		}
+	}
+
+	std::vector<std::string> recreated;
+	for (const auto& parameter : batch->getCreations()) {
+		if (_parameters.find(parameter.getName()) != nullptr) {
+			recreated.push_back(parameter.getName());
 		}
 	}
+
+	for (auto& response : responses) {
+		SDL_UserEvent event = co_await response;
+		vts::releaseResponse(event);
+	}
+
+	for (const auto& name : recreated) {
+		_parameters.reset(name);
+	}
+	if (!recreated.empty()) {
+		loadParameterSettings(recreated);
+	}
+	_listRefresh.flush(SDL_GetTicksNS());
+}
+
+// With a stored token, authentication and the parameter list request go out
+// back to back: VTS answers in order, so the list arrives one round trip
+// after the socket opens instead of after three. Model load and config
+// events are subscribed to once authenticated, so later list refreshes only
+// happen when VTS reports a change, or on a timer if it refuses them.
+vts::Task App::startSession() {
+	// Routing for the last model is compiled from the cache while the handshake
+	// is in flight; the live list then only has to confirm it.
+	if (const auto* model = _models.getActive(); model != nullptr) {
+		loadParameterSettings(_parameters.sync(vts::getNames(model->parameters)));
+	}
+
+	if (SETTINGS.getAuthToken(ws::PRIMARY_INSTANCE).empty()) {
+		SDL_UserEvent response = co_await _session.expect(
+		    vts::requestToken(_wsClient));
+		if (response.code != vts::ResponseCode::AUTHENTICATION_TOKEN) {
+			stopWs();
+			co_return;
+		}
+		auto* token = static_cast<std::string*>(response.data1);
+		SETTINGS.setAuthToken(ws::PRIMARY_INSTANCE, token->c_str());
+		vts::releaseResponse(response);
+	}
+
+	auto authentication = _session.expect(vts::authenticate(_wsClient));
+	auto parameterList  = _session.expect(vts::getParameters(_wsClient));
+
+	const SDL_UserEvent authResponse = co_await authentication;
+	if (authResponse.code == vts::ResponseCode::AUTHENTICATION_FAILURE) {
+		SETTINGS.setAuthToken(ws::PRIMARY_INSTANCE, "");
+		stopWs();
+		co_return;
+	}
+	if (authResponse.code != vts::ResponseCode::AUTHENTICATION_SUCCESS) {
+		stopWs();
+		co_return;
+	}
+	_wsClient.setStatus(ws::Status::AUTHENTICATED);
+	_isPollingModel = false;
+
+	std::deque<vts::PendingResponse> subscriptions;
+	subscriptions.emplace_back(
+	    _session,
+	    vts::subscribeEvent(_wsClient, "ModelLoadedEvent"));
+	subscriptions.emplace_back(
+	    _session,
+	    vts::subscribeEvent(_wsClient, "ModelConfigChangedEvent"));
+	if (!_items.isEmpty()) {
+		subscriptions.emplace_back(_session,
+		                           vts::subscribeEvent(_wsClient, "ItemEvent"));
+		vts::getItems(_wsClient);
+	}
+
+	SDL_UserEvent listResponse = co_await parameterList;
+	if (listResponse.code == vts::ResponseCode::INPUT_PARAMETER_LIST) {
+		handleVtsInputParameterList(listResponse);
+	}
+
+	// Older VTS builds reject event subscriptions. That only costs the pushed
+	// updates, so the list is polled instead of dropping the connection.
+	for (auto& subscription : subscriptions) {
+		SDL_UserEvent response = co_await subscription;
+		if (response.code != vts::ResponseCode::EVENT_SUBSCRIPTION) {
+			_isPollingModel = true;
+		}
+		vts::releaseResponse(response);
+	}
+	if (_isPollingModel) {
+		SDL_LogWarn(SDL_LOG_CATEGORY_APPLICATION,
+		            "VTS rejected event subscriptions; polling for model changes");
+		_nextModelPollNs = SDL_GetTicksNS() + MODEL_POLL_INTERVAL_NS;
+	}
 }
 
 void App::handleVtsMessage(SDL_UserEvent& event) {
+	REQUESTS.complete(core::pointerToUnsigned<Uint64>(event.data2),
+	                  SDL_GetTicksNS());
+	if (ws::getInstance(event) != ws::PRIMARY_INSTANCE) {
+		if (auto* mirror = findMirror(ws::getInstance(event))) {
+			mirror->handleMessage(event);
+		}
+		else {
+			vts::releaseResponse(event);
+		}
+		return;
+	}
+	if (_session.deliver(event)) {
+		return;
+	}
 	switch (event.code) {
 		case vts::ResponseCode::API_ERROR:
 			handleVtsApiError();
 			break;
 		case vts::ResponseCode::AUTHENTICATION_TOKEN:
-			handleVtsAuthenticationToken(event);
-			break;
-		case vts::ResponseCode::AUTHENTICATION_SUCCESS:
-			handleVtsAuthenticationSuccess();
-			break;
-		case vts::ResponseCode::AUTHENTICATION_FAILURE:
-			handleVtsAuthenticationFailure();
+			vts::releaseResponse(event);
 			break;
 		case vts::ResponseCode::INPUT_PARAMETER_LIST:
 			handleVtsInputParameterList(event);
 			break;
+		case vts::ResponseCode::MODEL_LOADED:
+			handleVtsModelLoaded(event);
+			break;
+		case vts::ResponseCode::MODEL_CONFIG_CHANGED:
+			refreshParameterList();
+			break;
+		case vts::ResponseCode::ITEM_LIST:
+		case vts::ResponseCode::ITEM_ADDED:
+		case vts::ResponseCode::ITEM_REMOVED:
+			handleVtsItemEvent(event);
+			break;
 		case vts::ResponseCode::PARAMETER_CREATION:
-			handleVtsParameterCreation();
+			handleVtsParameterCreation(event);
 			break;
 		case vts::ResponseCode::PARAMETER_DELETION:
 			handleVtsParameterDeletion();
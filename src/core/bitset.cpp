@@ -0,0 +1,35 @@
+#include "core/bitset.hpp"
+
+#include <algorithm>
+#include <cstddef>
+
+namespace core {
+
+DynamicBitset::DynamicBitset() :
+    _words() {}
+
+bool DynamicBitset::any() const {
+	return std::ranges::any_of(_words, [](const Uint64 w) { return w != 0; });
+}
+
+bool DynamicBitset::test(const std::size_t index) const {
+	return ((_words[index / WORD_BITS] >> (index % WORD_BITS)) & 1) != 0;
+}
+
+void DynamicBitset::clear() {
+	std::ranges::fill(_words, 0);
+}
+
+void DynamicBitset::reset(const std::size_t index) {
+	_words[index / WORD_BITS] &= ~(Uint64{1} << (index % WORD_BITS));
+}
+
+void DynamicBitset::resize(const std::size_t size) {
+	_words.resize((size + WORD_BITS - 1) / WORD_BITS, 0);
+}
+
+void DynamicBitset::set(const std::size_t index) {
+	_words[index / WORD_BITS] |= Uint64{1} << (index % WORD_BITS);
+}
+
+}  // namespace core
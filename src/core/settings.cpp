@@ -2,10 +2,13 @@
 
 #include <iostream>
 
+#include <algorithm>
+#include <cstddef>
 #include <format>
 #include <fstream>
 #include <iterator>
 #include <mutex>
+#include <span>
 #include <string>
 #include <vector>
 
@@ -19,6 +22,7 @@
 #include <glaze/json/read.hpp>
 #include <glaze/json/write.hpp>  // NOLINT(misc-include-cleaner)
 
+#include "impulse/generator.hpp"
 #include "math/geometry.hpp"
 #include "vts/parameter.hpp"
 
@@ -122,16 +126,29 @@ const math::Rectangle<int> SettingsManager::getMouseBounds() const {
 	return _data.mouseBounds;
 }
 
-const std::string SettingsManager::getAuthToken() const {
+// Index 0 is the instance at apiUrl; the rest follow the mirrors in order.
+const std::string SettingsManager::getAuthToken(const std::size_t index) const {
 	const std::lock_guard<std::mutex> lock(_mutex);
 
-	return _data.vtsToken;
+	if (index == 0) {
+		return _data.vtsToken;
+	}
+	if (index > _data.mirrors.size()) {
+		return {};
+	}
+	return _data.mirrors[index - 1].vtsToken;
 }
 
-const std::string SettingsManager::getWsUrl() const {
+const std::string SettingsManager::getWsUrl(const std::size_t index) const {
 	const std::lock_guard<std::mutex> lock(_mutex);
 
-	return _data.apiUrl;
+	if (index == 0) {
+		return _data.apiUrl;
+	}
+	if (index > _data.mirrors.size()) {
+		return {};
+	}
+	return _data.mirrors[index - 1].url;
 }
 
 const std::vector<SettingsParameter> SettingsManager::getParameters() const {
@@ -140,22 +157,62 @@ const std::vector<SettingsParameter> SettingsManager::getParameters() const {
 	return _data.parameters;
 }
 
+const std::vector<imp::GeneratorConfig> SettingsManager::getGenerators()
+    const {
+	const std::lock_guard<std::mutex> lock(_mutex);
+
+	return _data.generators;
+}
+
+const std::vector<SettingsItem> SettingsManager::getItems() const {
+	const std::lock_guard<std::mutex> lock(_mutex);
+
+	return _data.items;
+}
+
 float SettingsManager::getThemeHueShift() const {
 	const std::lock_guard<std::mutex> lock(_mutex);
 
 	return _data.themeHueShift;
 }
 
+int SettingsManager::getInjectionPrecision() const {
+	const std::lock_guard<std::mutex> lock(_mutex);
+
+	return _data.injectionPrecision;
+}
+
 int SettingsManager::getMouseSensitivity() const {
 	const std::lock_guard<std::mutex> lock(_mutex);
 
 	return _data.mouseSensitivity;
 }
 
-void SettingsManager::setAuthToken(const char* newAuthToken) {
+std::size_t SettingsManager::getInstanceCount() const {
+	const std::lock_guard<std::mutex> lock(_mutex);
+
+	return _data.mirrors.size() + 1;
+}
+
+void SettingsManager::setAuthToken(const std::size_t index,
+                                   const char*       newAuthToken) {
+	const std::lock_guard<std::mutex> lock(_mutex);
+
+	if (index == 0) {
+		_data.vtsToken = newAuthToken;
+	}
+	else if (index <= _data.mirrors.size()) {
+		_data.mirrors[index - 1].vtsToken = newAuthToken;
+	}
+
+	saveUnlocked();
+}
+
+void SettingsManager::setGenerators(
+    const std::vector<imp::GeneratorConfig>& generators) {
 	const std::lock_guard<std::mutex> lock(_mutex);
 
-	_data.vtsToken = newAuthToken;
+	_data.generators = generators;
 
 	saveUnlocked();
 }
@@ -176,9 +233,7 @@ void SettingsManager::setMouseSensitivity(const int newSensitivity) {
 	saveUnlocked();
 }
 
-void SettingsManager::setParameter(const vts::Parameter& parameter) {
-	const std::lock_guard<std::mutex> lock(_mutex);
-
+void SettingsManager::storeParameterUnlocked(const vts::Parameter& parameter) {
 	for (auto it = _data.parameters.begin(); it != _data.parameters.end(); ++it) {
 		if (it->name == parameter.getName()) {
 			_data.parameters.erase(it);
@@ -188,9 +243,39 @@ void SettingsManager::setParameter(const vts::Parameter& parameter) {
 
 	auto& newParameter = _data.parameters.emplace_back(parameter.getName(),
 	                                                   parameter.getBlendMode());
+	newParameter.epsilon         = parameter.getEpsilon();
+	newParameter.quantization    = parameter.getQuantization();
+	newParameter.expression      = parameter.getExpression();
+	newParameter.springFrequency = parameter.getSpringFrequency();
+	newParameter.springDamping   = parameter.getSpringDamping();
 
 	for (const auto& [code, receiver] : parameter.getReceivers()) {
-		newParameter.receivers.emplace_back(code, receiver.getIsInverted());
+		if (!parameter.isExpressionInput(code)) {
+			newParameter.receivers.emplace_back(code, receiver.getIsInverted());
+		}
+	}
+	for (const auto& link : parameter.getLinks()) {
+		newParameter.links.emplace_back(link.source, link.weight);
+	}
+}
+
+void SettingsManager::setParameter(const vts::Parameter& parameter) {
+	const std::lock_guard<std::mutex> lock(_mutex);
+
+	storeParameterUnlocked(parameter);
+
+	saveUnlocked();
+}
+
+void SettingsManager::setParameters(
+    const std::span<const vts::Parameter> parameters) {
+	const std::lock_guard<std::mutex> lock(_mutex);
+
+	if (parameters.empty()) {
+		return;
+	}
+	for (const auto& parameter : parameters) {
+		storeParameterUnlocked(parameter);
 	}
 
 	saveUnlocked();
@@ -204,10 +289,16 @@ void SettingsManager::setThemeHueShift(float shift) {
 	saveUnlocked();
 }
 
-void SettingsManager::setWsUrl(const char* newWsUrl) {
+void SettingsManager::setWsUrl(const std::size_t index,
+                               const char*       newWsUrl) {
 	const std::lock_guard<std::mutex> lock(_mutex);
 
-	_data.apiUrl = newWsUrl;
+	if (index == 0) {
+		_data.apiUrl = newWsUrl;
+	}
+	else if (index <= _data.mirrors.size()) {
+		_data.mirrors[index - 1].url = newWsUrl;
+	}
 
 	saveUnlocked();
 }
@@ -224,4 +315,16 @@ void SettingsManager::removeParameter(const std::string& name) {
 	}
 }
 
+void SettingsManager::removeParameters(
+    const std::span<const std::string> names) {
+	const std::lock_guard<std::mutex> lock(_mutex);
+
+	const auto isRemoved = [names](const SettingsParameter& parameter) {
+		return std::ranges::find(names, parameter.name) != names.end();
+	};
+	if (std::erase_if(_data.parameters, isRemoved) > 0) {
+		saveUnlocked();
+	}
+}
+
 }  // namespace core
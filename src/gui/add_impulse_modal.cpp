@@ -1,20 +1,33 @@
 #include "gui/add_impulse_modal.hpp"
 
+#include <algorithm>
+#include <format>
 #include <string>
 #include <vector>
 
 #include "imgui/imgui.h"
 
+#include "core/settings.hpp"
 #include "gui/utility.hpp"
+#include "impulse/clip.hpp"
 #include "impulse/code.hpp"
+#include "impulse/generator.hpp"
 
 namespace gui {
 
-static constexpr unsigned DEVICE_MOUSE    = 0;
-static constexpr unsigned DEVICE_KEYBOARD = 1;
-static constexpr unsigned DEVICE_GAMEPAD  = 2;
+static constexpr unsigned DEVICE_MOUSE     = 0;
+static constexpr unsigned DEVICE_KEYBOARD  = 1;
+static constexpr unsigned DEVICE_GAMEPAD   = 2;
+static constexpr unsigned DEVICE_GENERATOR = 3;
+static constexpr unsigned DEVICE_CLIP      = 4;
 
-static std::vector<const char*> DEVICES{"Mouse", "Keyboard", "Controller"};
+static std::vector<const char*> DEVICES{"Mouse",
+                                        "Keyboard",
+                                        "Controller",
+                                        "Generator",
+                                        "Clip"};
+
+static constexpr int MAX_CLIP_CHANNEL = 0xFFFF;
 
 static constexpr unsigned MOUSE_EVENT_BUTTON        = 0;
 static constexpr unsigned MOUSE_EVENT_WHEEL         = 1;
@@ -226,6 +239,15 @@ imp::Code AddImpulseModal::buildImpulseCode() const {
 				code |= getGamepadTriggerTag();
 				break;
 		}
+	}
+	else if (device == DEVICE_GENERATOR) {
+		const auto i = _generatorSelector.getIndex();
+		if (i < _generatorIds.size()) {
+			code = imp::makeGeneratorCode(_generatorIds[i]);
+		}
+	}
+	else if (device == DEVICE_CLIP) {
+		code = imp::makeClipCode(static_cast<Uint16>(_clipChannel));
 	};
 	return code;
 }
@@ -233,7 +255,7 @@ imp::Code AddImpulseModal::buildImpulseCode() const {
 void AddImpulseModal::showCloseButtons() {
 	if (ImGui::Button("Add", ImVec2(128.0F, 0.0F))) {
 		const imp::Code code = buildImpulseCode();
-		if (code != imp::EventTag::KEY) {
+		if (code != 0 && code != imp::EventTag::KEY) {
 			_editingParameter.addImpulse(code);
 			ImGui::CloseCurrentPopup();
 		}
@@ -375,6 +397,45 @@ void AddImpulseModal::showGamepadTriggerSelector() {
 	_gamepadTriggerSelector.show();
 }
 
+void AddImpulseModal::refreshGenerators() {
+	const auto generators = SETTINGS.getGenerators();
+	_generatorIds.clear();
+	_generatorNames.clear();
+	_generatorOptions.clear();
+	for (const auto& generator : generators) {
+		_generatorIds.push_back(generator.id);
+		_generatorNames.push_back(std::format("gen.{}", generator.id));
+	}
+	for (const auto& name : _generatorNames) {
+		_generatorOptions.push_back(name.c_str());
+	}
+	if (_generatorSelector.getIndex() >= _generatorOptions.size()
+	    && !_generatorOptions.empty()) {
+		_generatorSelector.setIndex(0);
+	}
+}
+
+void AddImpulseModal::showGeneratorControls() {
+	refreshGenerators();
+	ImGui::TableNextRow();
+	ImGui::TableNextColumn();
+	ImGui::Text("Generator");
+	ImGui::TableNextColumn();
+	_generatorSelector.show();
+}
+
+void AddImpulseModal::showClipControls() {
+	ImGui::TableNextRow();
+	ImGui::TableNextColumn();
+	ImGui::Text("Channel");
+	ImGui::TableNextColumn();
+	if (ImGui::InputInt("##clip-channel", &_clipChannel)) {
+		_clipChannel = std::clamp(_clipChannel, 0, MAX_CLIP_CHANNEL);
+	}
+	ImGui::SetItemTooltip(
+	    "The channel a clip track plays on, as set in clips.json.");
+}
+
 AddImpulseModal::AddImpulseModal(vts::Parameter& editingParameter) :
     _selectedKeyName(),
     _selectedKey(ImGuiKey_None),
@@ -388,7 +449,12 @@ AddImpulseModal::AddImpulseModal(vts::Parameter& editingParameter) :
     _gamepadEventSelector("##gamepad-event-selector", GAMEPAD_EVENTS),
     _gamepadStickActionSelector("##gamepad-stick-action-selector",
                                 GAMEPAD_STICK_ACTIONS),
-    _gamepadTriggerSelector("##gamepad-trigger-selector", GAMEPAD_SIDES) {}
+    _gamepadTriggerSelector("##gamepad-trigger-selector", GAMEPAD_SIDES),
+    _generatorIds(),
+    _generatorNames(),
+    _generatorOptions(),
+    _generatorSelector("##generator-selector", _generatorOptions),
+    _clipChannel(0) {}
 
 void AddImpulseModal::show() {
 	centerNextWindow();
@@ -412,6 +478,12 @@ void AddImpulseModal::show() {
 				case DEVICE_GAMEPAD:
 					showGamepadControls();
 					break;
+				case DEVICE_GENERATOR:
+					showGeneratorControls();
+					break;
+				case DEVICE_CLIP:
+					showClipControls();
+					break;
 			}
 
 			ImGui::EndTable();
@@ -201,8 +201,8 @@ ConfigParameterPanel::ConfigParameterPanel(
     _parameterManager(parameterManager),
     _wsController(wsController),
     _deleteParametersModal(parameterManager, wsController),
-    _editParameterModal(wsController, editingParameter),
-    _parameterTemplateModal(wsController),
+    _editParameterModal(wsController, parameterManager, editingParameter),
+    _parameterTemplateModal(),
     _filteredParameterNames(),
     _filterBuffer() {
 	SDL_zeroa(_filterBuffer);
@@ -1,18 +1,38 @@
 #include "gui/config_settings_panel.hpp"
 
+#include <algorithm>
 #include <cstddef>
 #include <format>
+#include <iterator>
 
 #include <SDL3/SDL_stdinc.h>
 
 #include "imgui/imgui.h"
 
 #include "gui/fonts.hpp"
+#include "impulse/generator.hpp"
 #include "vts/parameter.hpp"
+#include "vts/request_tracker.hpp"
 #include "ws/controller.hpp"
 
 namespace gui {
 
+static constexpr double MS_PER_US = 0.001;
+
+static constexpr const char* LATENCY_LABELS[] = {
+    "Authentication",
+    "Token",
+    "Parameter List",
+    "Create",
+    "Delete",
+    "Inject",
+    "Subscribe",
+    "Item List",
+    "Item Move",
+};
+
+static_assert(std::size(LATENCY_LABELS) == vts::N_REQUEST_TYPES);
+
 static constexpr const char* getStatusString(const ws::Status status) {
 	switch (status) {
 		case ws::Status::DISCONNECTED:
@@ -27,6 +47,42 @@ static constexpr const char* getStatusString(const ws::Status status) {
 	return "?";
 }
 
+void ConfigSettingsPanel::showClipSettings() {
+	{
+		FONT_SCOPE(FontType::BOLD);
+		ImGui::SeparatorText("Clips");
+	}
+
+	const auto& clips = _impulseProcessor.getClips();
+	if (!clips.empty()
+	    && ImGui::BeginTable("ClipSettings", 3, ImGuiTableFlags_SizingFixedFit)) {
+		ImGui::TableSetupColumn("Name", ImGuiTableColumnFlags_WidthStretch);
+		ImGui::TableSetupColumn("Hotkey", ImGuiTableColumnFlags_WidthFixed);
+		ImGui::TableSetupColumn("Tracks", ImGuiTableColumnFlags_WidthFixed);
+
+		for (const auto& clip : clips) {
+			ImGui::TableNextRow();
+			ImGui::TableNextColumn();
+			ImGui::Text("%s", clip.name.c_str());
+			ImGui::TableNextColumn();
+			ImGui::Text("%s", clip.hotkey.c_str());
+			ImGui::TableNextColumn();
+			ImGui::Text("%zu", clip.tracks.size());
+		}
+
+		ImGui::EndTable();
+	}
+
+	if (ImGui::Button("Reload Clips", ImVec2(-1.0F, 0.0F))) {
+		_impulseProcessor.reloadClips();
+	}
+	ImGui::SetItemTooltip(
+	    "Clips are short animations stored in clips.json. Each track plays "
+	    "on a channel that you can bind as a Clip input.");
+
+	ImGui::Spacing();
+}
+
 void ConfigSettingsPanel::showGamepadSettings() {
 	{
 		FONT_SCOPE(FontType::BOLD);
@@ -52,6 +108,175 @@ void ConfigSettingsPanel::showGamepadSettings() {
 	ImGui::Spacing();
 }
 
+static constexpr const char* WAVEFORMS[] = {
+    "Sine",
+    "Triangle",
+    "Noise",
+    "Blink",
+};
+
+static bool showWaveformCombo(imp::Waveform& waveform) {
+	const auto index   = static_cast<size_t>(waveform);
+	bool       changed = false;
+	if (ImGui::BeginCombo("##waveform", WAVEFORMS[index])) {
+		for (size_t i = 0; i < std::size(WAVEFORMS); ++i) {
+			if (ImGui::Selectable(WAVEFORMS[i], i == index)) {
+				waveform = static_cast<imp::Waveform>(i);
+				changed  = true;
+			}
+		}
+		ImGui::EndCombo();
+	}
+	return changed;
+}
+
+static Uint16 nextGeneratorId(
+    const std::vector<imp::GeneratorConfig>& configs) {
+	Uint16 id = 0;
+	for (const auto& config : configs) {
+		id = std::max<Uint16>(id, config.id + 1);
+	}
+	return id;
+}
+
+void ConfigSettingsPanel::showGeneratorSettings() {
+	{
+		FONT_SCOPE(FontType::BOLD);
+		ImGui::SeparatorText("Generators");
+	}
+
+	bool changed  = false;
+	auto toRemove = _generators.end();
+	if (!_generators.empty()
+	    && ImGui::BeginTable("GeneratorSettings",
+	                         5,
+	                         ImGuiTableFlags_SizingFixedFit)) {
+		ImGui::TableSetupColumn("Input", ImGuiTableColumnFlags_WidthFixed);
+		ImGui::TableSetupColumn("Waveform", ImGuiTableColumnFlags_WidthStretch);
+		ImGui::TableSetupColumn("Rate", ImGuiTableColumnFlags_WidthStretch);
+		ImGui::TableSetupColumn("Phase", ImGuiTableColumnFlags_WidthStretch);
+		ImGui::TableSetupColumn("Remove", ImGuiTableColumnFlags_WidthFixed);
+
+		for (auto it = _generators.begin(); it != _generators.end(); ++it) {
+			ImGui::PushID(it->id);
+			ImGui::TableNextRow();
+			ImGui::TableNextColumn();
+			ImGui::Text("gen.%d", it->id);
+			ImGui::TableNextColumn();
+			ImGui::SetNextItemWidth(-1.0F);
+			changed |= showWaveformCombo(it->waveform);
+			ImGui::TableNextColumn();
+			ImGui::SetNextItemWidth(-1.0F);
+			changed |= ImGui::SliderFloat("##rate",
+			                              &it->rate,
+			                              0.01F,
+			                              10.0F,
+			                              "%.2f Hz",
+			                              ImGuiSliderFlags_Logarithmic);
+			ImGui::TableNextColumn();
+			ImGui::SetNextItemWidth(-1.0F);
+			changed |= ImGui::SliderFloat("##phase", &it->phase, 0.0F, 1.0F);
+			ImGui::TableNextColumn();
+			if (ImGui::SmallButton("X")) {
+				toRemove = it;
+			}
+			ImGui::PopID();
+		}
+
+		ImGui::EndTable();
+	}
+
+	if (toRemove != _generators.end()) {
+		_generators.erase(toRemove);
+		changed = true;
+	}
+	if (ImGui::Button("Add Generator", ImVec2(-1.0F, 0.0F))) {
+		_generators.push_back({.id = nextGeneratorId(_generators)});
+		changed = true;
+	}
+	ImGui::SetItemTooltip(
+	    "Generators produce inputs on their own, such as a slow sway or a "
+	    "random blink.\n\nBind them to a parameter like any other input.");
+	if (changed) {
+		_impulseProcessor.setGenerators(_generators);
+	}
+
+	ImGui::Spacing();
+}
+
+void ConfigSettingsPanel::showLatencySettings() {
+	{
+		FONT_SCOPE(FontType::BOLD);
+		ImGui::SeparatorText("VTS Latency");
+	}
+
+	if (ImGui::BeginTable("LatencySettings", 6, ImGuiTableFlags_SizingFixedFit)) {
+		ImGui::TableSetupColumn("Request", ImGuiTableColumnFlags_WidthStretch);
+		ImGui::TableSetupColumn("Count", ImGuiTableColumnFlags_WidthFixed);
+		ImGui::TableSetupColumn("p50", ImGuiTableColumnFlags_WidthFixed);
+		ImGui::TableSetupColumn("p99", ImGuiTableColumnFlags_WidthFixed);
+		ImGui::TableSetupColumn("Max", ImGuiTableColumnFlags_WidthFixed);
+		ImGui::TableSetupColumn("Timeouts", ImGuiTableColumnFlags_WidthFixed);
+		ImGui::TableHeadersRow();
+
+		for (std::size_t i = 0; i < vts::N_REQUEST_TYPES; ++i) {
+			const auto  type      = static_cast<vts::RequestType>(i);
+			const auto& histogram = REQUESTS.getHistogram(type);
+			ImGui::TableNextRow();
+			ImGui::TableNextColumn();
+			ImGui::Text("%s", LATENCY_LABELS[i]);
+			ImGui::TableNextColumn();
+			ImGui::Text("%llu",
+			            static_cast<unsigned long long>(histogram.getCount()));
+			ImGui::TableNextColumn();
+			ImGui::Text("%.1f ms", histogram.getPercentileUs(0.5) * MS_PER_US);
+			ImGui::TableNextColumn();
+			ImGui::Text("%.1f ms", histogram.getPercentileUs(0.99) * MS_PER_US);
+			ImGui::TableNextColumn();
+			ImGui::Text("%.1f ms", histogram.getMaxUs() * MS_PER_US);
+			ImGui::TableNextColumn();
+			ImGui::Text("%llu",
+			            static_cast<unsigned long long>(REQUESTS.getTimeouts(type)));
+		}
+
+		const auto queueLatency = _wsController.getQueueLatency();
+		ImGui::TableNextRow();
+		ImGui::TableNextColumn();
+		ImGui::Text("Send Queue");
+		ImGui::TableNextColumn();
+		ImGui::Text("%llu",
+		            static_cast<unsigned long long>(queueLatency.getCount()));
+		ImGui::TableNextColumn();
+		ImGui::Text("%.1f ms", queueLatency.getPercentileUs(0.5) * MS_PER_US);
+		ImGui::TableNextColumn();
+		ImGui::Text("%.1f ms", queueLatency.getPercentileUs(0.99) * MS_PER_US);
+		ImGui::TableNextColumn();
+		ImGui::Text("%.1f ms", queueLatency.getMaxUs() * MS_PER_US);
+		ImGui::TableNextColumn();
+		ImGui::Text("-");
+
+		ImGui::EndTable();
+	}
+
+	ImGui::Text("Dropped Frames: %llu",
+	            static_cast<unsigned long long>(_wsController.getDroppedFrames()));
+	ImGui::SetItemTooltip(
+	    "Parameter frames replaced by newer ones while the connection was too "
+	    "busy to send them.");
+
+	if (ImGui::Button("Reset Latency", ImVec2(-1.0F, 0.0F))) {
+		REQUESTS.clearStatistics();
+		_wsController.clearQueueLatency();
+	}
+	ImGui::SetItemTooltip(
+	    "Round-trip times measured from sending a request to VTube Studio "
+	    "until its response arrives. Requests unanswered after five seconds "
+	    "count as timeouts.\n\nSend Queue is the time a message waits before "
+	    "it is written to the socket.");
+
+	ImGui::Spacing();
+}
+
 void ConfigSettingsPanel::showMouseMotionSettings() {
 	{
 		FONT_SCOPE(FontType::BOLD);
@@ -220,7 +445,8 @@ ConfigSettingsPanel::ConfigSettingsPanel(pad::Manager&    gamepadManager,
     _setMouseBoundsModal(impulseProcessor, editingParameter),
     _urlBuffer(),
     _gamepadSelector("##active-gamepad", _gamepadManager.getNames()),
-    _mouseSensitivity(_impulseProcessor.getMouseSensitivity()) {
+    _mouseSensitivity(_impulseProcessor.getMouseSensitivity()),
+    _generators(_impulseProcessor.getGenerators()) {
 	SDL_strlcpy(_urlBuffer, wsController.getUrl(), sizeof(_urlBuffer));
 }
 
@@ -231,9 +457,12 @@ void ConfigSettingsPanel::show() {
 	                      ImGuiChildFlags_None,
 	                      ImGuiWindowFlags_NoSavedSettings)) {
 		showVtsSettings();
+		showLatencySettings();
 		showGamepadSettings();
 		showMouseMotionSettings();
 		showMousePositionSettings();
+		showGeneratorSettings();
+		showClipSettings();
 	}
 	showModals();
 	ImGui::EndChild();
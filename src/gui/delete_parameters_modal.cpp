@@ -3,12 +3,14 @@
 #include <algorithm>
 #include <functional>
 #include <ranges>
+#include <utility>
 
 #include "imgui/imgui.h"
 
+#include "gui/event.hpp"
 #include "gui/utility.hpp"
+#include "vts/parameter_batch.hpp"
 #include "vts/parameter_manager.hpp"
-#include "vts/request.hpp"
 #include "ws/controller.hpp"
 
 namespace gui {
@@ -47,11 +49,13 @@ void DeleteParametersModal::show() {
 		}
 
 		if (ImGui::Button("Delete", ImVec2(128.0F, 0.0F))) {
+			vts::ParameterBatch batch;
 			for (auto& p : _parameterManager.values()) {
 				if (_selectedState[p.getName()]) {
-					vts::deleteParameter(_wsController, p.getName());
+					batch.remove(p.getName());
 				}
 			}
+			pushParameterBatch(std::move(batch));
 			ImGui::CloseCurrentPopup();
 		}
 		ImGui::SetItemDefaultFocus();
@@ -16,6 +16,7 @@
 #include "gui/utility.hpp"
 #include "impulse/code.hpp"
 #include "vts/parameter.hpp"
+#include "vts/parameter_manager.hpp"
 #include "vts/request.hpp"
 #include "ws/controller.hpp"
 
@@ -23,9 +24,11 @@ namespace gui {
 
 static constexpr const char* UNKNOWN = "UNKNOWN";
 
-static constexpr const char* DEVICE_MOUSE    = "Mouse";
-static constexpr const char* DEVICE_KEYBOARD = "Keyboard";
-static constexpr const char* DEVICE_GAMEPAD  = "Controller";
+static constexpr const char* DEVICE_MOUSE     = "Mouse";
+static constexpr const char* DEVICE_KEYBOARD  = "Keyboard";
+static constexpr const char* DEVICE_GAMEPAD   = "Controller";
+static constexpr const char* DEVICE_GENERATOR = "Generator";
+static constexpr const char* DEVICE_CLIP      = "Clip";
 
 static constexpr const char* MOUSE_EVENT_BUTTON        = "Button";
 static constexpr const char* MOUSE_EVENT_WHEEL         = "Wheel";
@@ -36,6 +39,8 @@ static constexpr const char* GAMEPAD_EVENT_BUTTON      = "Button";
 static constexpr const char* GAMEPAD_EVENT_TRIGGER     = "Trigger";
 static constexpr const char* GAMEPAD_EVENT_STICK_LEFT  = "Motion (LStick)";
 static constexpr const char* GAMEPAD_EVENT_STICK_RIGHT = "Motion (RStick)";
+static constexpr const char* GENERATOR_EVENT_WAVE      = "Wave";
+static constexpr const char* CLIP_EVENT_TRACK          = "Track";
 
 static const char* MOUSE_BUTTONS[] = {"Left", "Right", "Middle"};
 
@@ -63,6 +68,20 @@ static constexpr unsigned BLEND_MODE_BOUNDED_SUM = 1;
 
 static std::vector<const char*> BLEND_MODES = {"Max", "Sum (Bound)"};
 
+static std::vector<const char*> QUANTIZATIONS = {"Off",
+                                                 "1/256",
+                                                 "1/1024",
+                                                 "1/4096"};
+
+static constexpr int QUANTIZATION_STEPS[] = {0, 256, 1024, 4096};
+
+static constexpr float MAX_EPSILON = 0.1F;
+
+static constexpr float MAX_LINK_WEIGHT = 2.0F;
+
+static constexpr float MAX_SPRING_DAMPING   = 2.0F;
+static constexpr float MAX_SPRING_FREQUENCY = 20.0F;
+
 static constexpr auto NAME_PREFIX = "MK_";
 static constexpr int  NAME_PREFIX_LENGTH =
     std::char_traits<char>::length(NAME_PREFIX);
@@ -70,7 +89,7 @@ static constexpr int  NAME_PREFIX_LENGTH =
 struct ImpulseStrings {
 	const char* device = UNKNOWN;
 	const char* event  = UNKNOWN;
-	const char* target = UNKNOWN;
+	std::string target = UNKNOWN;
 };
 
 ImpulseStrings getImpulseStrings(const imp::Code code) {
@@ -123,6 +142,16 @@ ImpulseStrings getImpulseStrings(const imp::Code code) {
 			strings.event  = GAMEPAD_EVENT_STICK_RIGHT;
 			strings.target = AXES[target - 1];
 			break;
+		case imp::EventTag::GENERATOR:
+			strings.device = DEVICE_GENERATOR;
+			strings.event  = GENERATOR_EVENT_WAVE;
+			strings.target = std::format("gen.{}", target);
+			break;
+		case imp::EventTag::CLIP:
+			strings.device = DEVICE_CLIP;
+			strings.event  = CLIP_EVENT_TRACK;
+			strings.target = std::format("clip.{}", target);
+			break;
 	}
 	return strings;
 }
@@ -135,6 +164,26 @@ void EditParameterModal::showAddImpulse() {
 	_addImpulseModal.show();
 }
 
+void EditParameterModal::showAddLink() {
+	ImGui::SetNextItemWidth(128.0F);
+	if (ImGui::BeginCombo("##add-link", "Link", 0)) {
+		for (const auto& parameter : _parameterManager.values()) {
+			const auto& name = parameter.getName();
+			if (name == _editingParameter.getName()) {
+				continue;
+			}
+			if (ImGui::Selectable(name.c_str(), false)) {
+				addLink(name);
+			}
+		}
+		ImGui::EndCombo();
+	}
+	if (!_linkError.empty()) {
+		ImGui::SameLine();
+		ImGui::TextWrapped("%s", _linkError.c_str());
+	}
+}
+
 void EditParameterModal::showImpulses() {
 	{
 		FONT_SCOPE(FontType::BOLD);
@@ -171,11 +220,12 @@ void EditParameterModal::showImpulses() {
 			ImGui::Text("%s", fields.event);
 
 			ImGui::TableNextColumn();
-			ImGui::Text("%s", fields.target);
+			ImGui::Text("%s", fields.target.c_str());
 
 			ImGui::TableNextColumn();
-			if (ImGui::Checkbox("##invert-impulse", &data.isInvertedRef())) {
-				_editingParameter.updateBounds();
+			bool isInverted = data.getIsInverted();
+			if (ImGui::Checkbox("##invert-impulse", &isInverted)) {
+				_editingParameter.setInverted(code, isInverted);
 			}
 
 			ImGui::TableNextColumn();
@@ -205,6 +255,75 @@ void EditParameterModal::showImpulses() {
 	ImGui::PopStyleVar();
 }
 
+void EditParameterModal::showLinks() {
+	{
+		FONT_SCOPE(FontType::BOLD);
+		ImGui::SeparatorText("Links");
+	}
+
+	ImGui::PushStyleVar(ImGuiStyleVar_CellPadding, ImVec2(12.0F, 2.0F));
+
+	auto& links = _editingParameter.getLinks();
+	if (ImGui::BeginTable("Link Table",
+	                      4,
+	                      ImGuiTableFlags_PadOuterX
+	                          | ImGuiTableFlags_RowBg
+	                          | ImGuiTableFlags_SizingFixedFit)) {
+		ImGui::TableSetupColumn("Source", ImGuiTableColumnFlags_WidthFixed);
+		ImGui::TableSetupColumn("Weight", ImGuiTableColumnFlags_WidthFixed);
+		ImGui::TableSetupColumn("Value", ImGuiTableColumnFlags_WidthStretch);
+		ImGui::TableSetupColumn("Remove", ImGuiTableColumnFlags_WidthFixed);
+		if (!links.empty()) {
+			ImGui::TableHeadersRow();
+		}
+
+		for (size_t i = 0; i < links.size(); ++i) {
+			auto& link = links[i];
+			ImGui::PushID(static_cast<int>(i));
+
+			ImGui::TableNextRow();
+			ImGui::TableNextColumn();
+			ImGui::Text("%s", link.source.c_str());
+
+			ImGui::TableNextColumn();
+			ImGui::SetNextItemWidth(96.0F);
+			if (ImGui::SliderFloat("##link-weight",
+			                       &link.weight,
+			                       -MAX_LINK_WEIGHT,
+			                       MAX_LINK_WEIGHT,
+			                       "%.2f")) {
+				_editingParameter.updateBounds();
+			}
+
+			ImGui::TableNextColumn();
+			ImGui::SetNextItemWidth(128.0F);
+			ImGui::BeginDisabled();
+			float value = link.value;
+			ImGui::SliderFloat("##link-value",
+			                   &value,
+			                   link.min,
+			                   link.max,
+			                   "%.3f",
+			                   ImGuiSliderFlags_NoInput);
+			ImGui::EndDisabled();
+
+			ImGui::TableNextColumn();
+			const float rowHeight = ImGui::GetTextLineHeightWithSpacing();
+			if (ImGui::Button("X", ImVec2(rowHeight, rowHeight))) {
+				_linkToDelete = link.source;
+			}
+
+			ImGui::PopID();
+		}
+
+		ImGui::EndTable();
+	}
+
+	ImGui::PopStyleVar();
+
+	showAddLink();
+}
+
 void EditParameterModal::showMeta() {
 	{
 		FONT_SCOPE(FontType::BOLD);
@@ -250,6 +369,86 @@ void EditParameterModal::showOutput() {
 			updateBlendMode();
 		}
 
+		ImGui::TableNextRow();
+		ImGui::TableNextColumn();
+		ImGui::Text("Epsilon");
+		ImGui::TableNextColumn();
+		ImGui::SetNextItemWidth(-1.0F);
+		float epsilon = _editingParameter.getEpsilon();
+		if (ImGui::SliderFloat("##epsilon-slider",
+		                       &epsilon,
+		                       0.0F,
+		                       MAX_EPSILON,
+		                       "%.4f",
+		                       ImGuiSliderFlags_AlwaysClamp)) {
+			_editingParameter.setEpsilon(epsilon);
+		}
+
+		ImGui::TableNextRow();
+		ImGui::TableNextColumn();
+		ImGui::Text("Quantization");
+		ImGui::TableNextColumn();
+		if (_quantizationSelector.show()) {
+			_editingParameter.setQuantization(
+			    QUANTIZATION_STEPS[_quantizationSelector.getIndex()]);
+		}
+
+		ImGui::TableNextRow();
+		ImGui::TableNextColumn();
+		ImGui::Text("Spring");
+		ImGui::TableNextColumn();
+		ImGui::SetNextItemWidth(-1.0F);
+		float frequency = _editingParameter.getSpringFrequency();
+		float damping   = _editingParameter.getSpringDamping();
+		if (ImGui::SliderFloat("##spring-frequency-slider",
+		                       &frequency,
+		                       0.0F,
+		                       MAX_SPRING_FREQUENCY,
+		                       frequency > 0.0F ? "%.1f Hz" : "Off",
+		                       ImGuiSliderFlags_AlwaysClamp)) {
+			_editingParameter.setSpring(frequency, damping);
+		}
+		ImGui::SetItemTooltip(
+		    "Lets the output follow its inputs like a spring, overshooting and "
+		    "settling.\n\nHigher frequencies follow more tightly.");
+
+		ImGui::TableNextRow();
+		ImGui::TableNextColumn();
+		ImGui::Text("Damping");
+		ImGui::TableNextColumn();
+		ImGui::SetNextItemWidth(-1.0F);
+		ImGui::BeginDisabled(!_editingParameter.hasSpring());
+		if (ImGui::SliderFloat("##spring-damping-slider",
+		                       &damping,
+		                       0.0F,
+		                       MAX_SPRING_DAMPING,
+		                       "%.2f",
+		                       ImGuiSliderFlags_AlwaysClamp)) {
+			_editingParameter.setSpring(frequency, damping);
+		}
+		ImGui::EndDisabled();
+		ImGui::SetItemTooltip(
+		    "Below 1 the spring overshoots before settling; at 1 and above it "
+		    "settles without overshoot.");
+
+		ImGui::TableNextRow();
+		ImGui::TableNextColumn();
+		ImGui::Text("Expression");
+		ImGui::TableNextColumn();
+		ImGui::SetNextItemWidth(-1.0F);
+		ImGui::InputTextWithHint("##expression-field",
+		                         "blend",
+		                         _expressionBuffer,
+		                         IM_ARRAYSIZE(_expressionBuffer));
+		if (ImGui::IsItemDeactivatedAfterEdit()) {
+			updateExpression();
+		}
+		if (_expressionError) {
+			ImGui::TextWrapped("Column %zu: %s",
+			                   _expressionError->position + 1,
+			                   _expressionError->message.c_str());
+		}
+
 		ImGui::TableNextRow();
 		ImGui::TableNextColumn();
 		ImGui::Text("Minimum");
@@ -311,6 +510,17 @@ int EditParameterModal::inputNameCallback(ImGuiInputTextCallbackData* data) {
 	return instance->restrictInputName(data);
 }
 
+void EditParameterModal::addLink(const std::string& source) {
+	auto links = _editingParameter.getLinks();
+	links.push_back({.source = source});
+	if (_parameterManager.createsCycle(_editingParameter.getName(), links)) {
+		_linkError = std::format("{} already depends on this parameter", source);
+		return;
+	}
+	_linkError.clear();
+	_editingParameter.addLink(source, 1.0F);
+}
+
 void EditParameterModal::checkDeleteImpulse() {
 	if (_impulseCodeToDelete == 0) {
 		return;
@@ -319,11 +529,20 @@ void EditParameterModal::checkDeleteImpulse() {
 	_impulseCodeToDelete = 0;
 }
 
+void EditParameterModal::checkDeleteLink() {
+	if (_linkToDelete.empty()) {
+		return;
+	}
+	_editingParameter.removeLink(_linkToDelete);
+	_linkToDelete.clear();
+}
+
 void EditParameterModal::save() {
 	if (_initialName != _editingParameter.getName()) {
 		SETTINGS.removeParameter(_initialName);
 		vts::deleteParameter(_wsController, _initialName);
 	}
+	updateExpression();
 	SETTINGS.setParameter(_editingParameter);
 	vts::createParameter(_wsController, _editingParameter);
 }
@@ -339,19 +558,39 @@ void EditParameterModal::updateBlendMode() {
 	}
 }
 
-EditParameterModal::EditParameterModal(ws::IController& wsController,
-                                       vts::Parameter&  editingParameter) :
+void EditParameterModal::updateExpression() {
+	if (_editingParameter.getExpression() == _expressionBuffer) {
+		return;
+	}
+	_expressionError = _editingParameter.setExpression(_expressionBuffer);
+}
+
+EditParameterModal::EditParameterModal(
+    ws::IController&       wsController,
+    vts::ParameterManager& parameterManager,
+    vts::Parameter&        editingParameter) :
     _wsController(wsController),
+    _parameterManager(parameterManager),
     _editingParameter(editingParameter),
     _addImpulseModal(editingParameter),
     _blendModeSelector("##blend-mode-selector", BLEND_MODES),
+    _quantizationSelector("##quantization-selector", QUANTIZATIONS),
+    _expressionBuffer{},
+    _expressionError(),
     _outputHistory{},
     _outputOffset(0),
-    _impulseCodeToDelete(0) {}
+    _impulseCodeToDelete(0),
+    _linkToDelete(),
+    _linkError() {}
 
 void EditParameterModal::refresh() {
 	_initialName = _editingParameter.getName();
 	SDL_strlcpy(_nameFieldBuffer, _initialName.c_str(), MAX_NAME_BUFFER_LENGTH);
+	SDL_strlcpy(_expressionBuffer,
+	            _editingParameter.getExpression().c_str(),
+	            MAX_EXPRESSION_BUFFER_LENGTH);
+	_expressionError.reset();
+	_linkError.clear();
 	_outputHistory.fill(0.0F);
 	switch (_editingParameter.getBlendMode()) {
 		case vts::BlendMode::MAX:
@@ -361,6 +600,12 @@ void EditParameterModal::refresh() {
 			_blendModeSelector.setIndex(BLEND_MODE_BOUNDED_SUM);
 			break;
 	}
+	_quantizationSelector.setIndex(0);
+	for (size_t i = 0; i < std::size(QUANTIZATION_STEPS); ++i) {
+		if (QUANTIZATION_STEPS[i] == _editingParameter.getQuantization()) {
+			_quantizationSelector.setIndex(i);
+		}
+	}
 }
 
 void EditParameterModal::show() {
@@ -374,8 +619,10 @@ void EditParameterModal::show() {
 		showMeta();
 		showImpulses();
 		showAddImpulse();
+		showLinks();
 		showOutput();
 		checkDeleteImpulse();
+		checkDeleteLink();
 
 		if (ImGui::Button("Save", ImVec2(128.0F, 0.0F))) {
 			save();
@@ -1,15 +1,29 @@
 #include "gui/event.hpp"
 
 #include <cstddef>
+#include <utility>
 
 #include <SDL3/SDL_events.h>
 
+#include "vts/parameter_batch.hpp"
+
 namespace gui {
 
-static const size_t N_EVENTS = 1;
+static const size_t N_EVENTS = 2;
 
 void allocateEvents() {
 	SDL_RegisterEvents(N_EVENTS);
 }
 
+void pushParameterBatch(vts::ParameterBatch&& batch) {
+	if (batch.isEmpty()) {
+		return;
+	}
+	SDL_Event event;
+	SDL_zero(event);
+	event.type       = Event::PARAMETER_BATCH;
+	event.user.data1 = new vts::ParameterBatch(std::move(batch));
+	SDL_PushEvent(&event);
+}
+
 }  // namespace gui
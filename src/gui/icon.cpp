@@ -181,6 +181,10 @@ static IconMap gamepadStickRightStrings{
     {imp::Axis::Y, "\u21F5"},
 };
 
+static IconMap generatorStrings{};
+
+static IconMap clipStrings{};
+
 static const std::unordered_map<const char*, float> Y_OFFSETS{
     {"\uE0E2", -3.0F},
     {"\uE0F2", 3.0F },
@@ -234,6 +238,12 @@ void drawIcon(const imp::Code code, const float alpha) {
 		case imp::EventTag::GAMEPAD_STICK_RIGHT:
 			drawIconOrDefault(target, alpha, gamepadStickRightStrings, "\u21CC");
 			break;
+		case imp::EventTag::GENERATOR:
+			drawIconOrDefault(target, alpha, generatorStrings, "\u2426");
+			break;
+		case imp::EventTag::CLIP:
+			drawIconOrDefault(target, alpha, clipStrings, "\u2427");
+			break;
 	}
 }
 
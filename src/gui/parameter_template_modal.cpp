@@ -2,17 +2,17 @@
 
 #include <array>
 #include <cstddef>
+#include <utility>
 #include <vector>
 
 #include "imgui/imgui.h"
 #include "libuiohook/uiohook.h"
 
-#include "core/settings.hpp"
+#include "gui/event.hpp"
 #include "gui/utility.hpp"
 #include "impulse/code.hpp"
 #include "vts/parameter.hpp"
-#include "vts/request.hpp"
-#include "ws/controller.hpp"
+#include "vts/parameter_batch.hpp"
 
 static constexpr size_t TEMPLATE_CONTROLLER = 0;
 static constexpr size_t TEMPLATE_BRUSH      = 1;
@@ -39,27 +39,23 @@ const auto PRESS_RIGHT_GAMEPAD_IMPULSES = std::to_array<imp::Code>(
 
 namespace gui {
 
-void BrushTemplate::createPositionParameters(ws::IController& wsController) {
+void BrushTemplate::createPositionParameters(vts::ParameterBatch& batch) {
 	vts::Parameter brushX("MK_BrushX");
 	vts::Parameter brushY("MK_BrushY");
 
 	brushX.addImpulse(imp::Axis::X | imp::EventTag::MOUSE_MOVE_ABS);
 	brushY.addImpulse(imp::Axis::Y | imp::EventTag::MOUSE_MOVE_ABS);
 
-	SETTINGS.setParameter(brushX);
-	SETTINGS.setParameter(brushY);
-
-	vts::createParameter(wsController, brushX);
-	vts::createParameter(wsController, brushY);
+	batch.create(brushX);
+	batch.create(brushY);
 }
 
-void BrushTemplate::createStrokeParameters(ws::IController& wsController) {
+void BrushTemplate::createStrokeParameters(vts::ParameterBatch& batch) {
 	vts::Parameter brushStroke("MK_BrushStroke");
 
 	brushStroke.addImpulse(imp::MouseButton::LEFT | imp::EventTag::MOUSE_BUTTON);
 
-	SETTINGS.setParameter(brushStroke);
-	vts::createParameter(wsController, brushStroke);
+	batch.create(brushStroke);
 }
 
 BrushTemplate::BrushTemplate() :
@@ -70,12 +66,12 @@ bool BrushTemplate::isValid() const {
 	return _hasPosition || _hasStroke;
 }
 
-void BrushTemplate::execute(ws::IController& wsController) {
+void BrushTemplate::execute(vts::ParameterBatch& batch) {
 	if (_hasPosition) {
-		createPositionParameters(wsController);
+		createPositionParameters(batch);
 	}
 	if (_hasStroke) {
-		createStrokeParameters(wsController);
+		createStrokeParameters(batch);
 	}
 }
 
@@ -101,7 +97,7 @@ void BrushTemplate::show() {
 }
 
 void ControllerTemplate::createPressParameters(
-    ws::IController& wsController) const {
+    vts::ParameterBatch& batch) const {
 	vts::Parameter leftPress("MK_LPress");
 	vts::Parameter rightPress("MK_RPress");
 
@@ -123,14 +119,12 @@ void ControllerTemplate::createPressParameters(
 		}
 	}
 
-	SETTINGS.setParameter(leftPress);
-	SETTINGS.setParameter(rightPress);
-	vts::createParameter(wsController, leftPress);
-	vts::createParameter(wsController, rightPress);
+	batch.create(leftPress);
+	batch.create(rightPress);
 }
 
 void ControllerTemplate::createShoulderParameters(
-    ws::IController& wsController) const {
+    vts::ParameterBatch& batch) const {
 	vts::Parameter leftShoulder("MK_LShoulder");
 	vts::Parameter rightShoulder("MK_RShoulder");
 
@@ -146,14 +140,12 @@ void ControllerTemplate::createShoulderParameters(
 		                         | imp::EventTag::GAMEPAD_BUTTON);
 	}
 
-	SETTINGS.setParameter(leftShoulder);
-	SETTINGS.setParameter(rightShoulder);
-	vts::createParameter(wsController, leftShoulder);
-	vts::createParameter(wsController, rightShoulder);
+	batch.create(leftShoulder);
+	batch.create(rightShoulder);
 }
 
 void ControllerTemplate::createStickParameters(
-    ws::IController& wsController) const {
+    vts::ParameterBatch& batch) const {
 	vts::Parameter leftStickX("MK_LStickX");
 	leftStickX.setBlendMode(vts::BlendMode::BOUNDED_SUM);
 	vts::Parameter leftStickY("MK_LStickY");
@@ -190,18 +182,14 @@ void ControllerTemplate::createStickParameters(
 		rightStickY.addImpulse(imp::Axis::Y | imp::EventTag::GAMEPAD_STICK_RIGHT);
 	}
 
-	SETTINGS.setParameter(leftStickX);
-	SETTINGS.setParameter(leftStickY);
-	SETTINGS.setParameter(rightStickX);
-	SETTINGS.setParameter(rightStickY);
-	vts::createParameter(wsController, leftStickX);
-	vts::createParameter(wsController, leftStickY);
-	vts::createParameter(wsController, rightStickX);
-	vts::createParameter(wsController, rightStickY);
+	batch.create(leftStickX);
+	batch.create(leftStickY);
+	batch.create(rightStickX);
+	batch.create(rightStickY);
 }
 
 void ControllerTemplate::createTriggerParameters(
-    ws::IController& wsController) const {
+    vts::ParameterBatch& batch) const {
 	vts::Parameter leftTrigger("MK_LTrigger");
 	vts::Parameter rightTrigger("MK_RTrigger");
 
@@ -215,10 +203,8 @@ void ControllerTemplate::createTriggerParameters(
 		rightTrigger.addImpulse(imp::Side::RIGHT | imp::EventTag::GAMEPAD_TRIGGER);
 	}
 
-	SETTINGS.setParameter(leftTrigger);
-	SETTINGS.setParameter(rightTrigger);
-	vts::createParameter(wsController, leftTrigger);
-	vts::createParameter(wsController, rightTrigger);
+	batch.create(leftTrigger);
+	batch.create(rightTrigger);
 }
 
 ControllerTemplate::ControllerTemplate() :
@@ -234,18 +220,18 @@ bool ControllerTemplate::isValid() const {
 	       && (_useController || _useMouseKeyboard);
 }
 
-void ControllerTemplate::execute(ws::IController& wsController) {
+void ControllerTemplate::execute(vts::ParameterBatch& batch) {
 	if (_hasPress) {
-		createPressParameters(wsController);
+		createPressParameters(batch);
 	}
 	if (_hasShoulders) {
-		createShoulderParameters(wsController);
+		createShoulderParameters(batch);
 	}
 	if (_hasSticks) {
-		createStickParameters(wsController);
+		createStickParameters(batch);
 	}
 	if (_hasTriggers) {
-		createTriggerParameters(wsController);
+		createTriggerParameters(batch);
 	}
 }
 
@@ -298,14 +284,16 @@ bool ParameterTemplateModal::isValid() const {
 }
 
 void ParameterTemplateModal::execute() {
+	vts::ParameterBatch batch;
 	switch (_templateSelector.getIndex()) {
 		case TEMPLATE_CONTROLLER:
-			_controllerTemplate.execute(_wsController);
+			_controllerTemplate.execute(batch);
 			break;
 		case TEMPLATE_BRUSH:
-			_brushTemplate.execute(_wsController);
+			_brushTemplate.execute(batch);
 			break;
 	}
+	pushParameterBatch(std::move(batch));
 }
 
 static constexpr ImVec2 DEFAULT_BUTTON_SIZE{128.0F, 0.0F};
@@ -324,8 +312,7 @@ void ParameterTemplateModal::showCloseButtons() {
 	}
 }
 
-ParameterTemplateModal::ParameterTemplateModal(ws::IController& wsController) :
-    _wsController(wsController),
+ParameterTemplateModal::ParameterTemplateModal() :
     _templateSelector("##template-selector", TEMPLATES) {}
 
 void ParameterTemplateModal::show() {
@@ -0,0 +1,203 @@
+#include "impulse/clip.hpp"
+
+#include <algorithm>
+#include <cstddef>
+#include <fstream>
+#include <iterator>
+#include <optional>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include <SDL3/SDL_log.h>
+#include <SDL3/SDL_stdinc.h>
+#include <glaze/core/common.hpp>
+#include <glaze/core/meta.hpp>
+#include <glaze/json/read.hpp>
+
+#include "impulse/code.hpp"
+#include "impulse/symbol.hpp"
+
+template <>
+struct glz::meta<imp::Interpolation> {
+	using enum imp::Interpolation;
+	static constexpr auto value = glz::enumerate(LINEAR, CUBIC);
+};
+
+template <>
+struct glz::meta<imp::Keyframe> {
+	using T                     = imp::Keyframe;
+	static constexpr auto value = glz::array(&T::time, &T::value);
+};
+
+template <>
+struct glz::meta<imp::ClipTrack> {
+	using T                     = imp::ClipTrack;
+	static constexpr auto value = object("channel",
+	                                     &T::channel,
+	                                     "interpolation",
+	                                     &T::interpolation,
+	                                     "keyframes",
+	                                     &T::keyframes);
+};
+
+template <>
+struct glz::meta<imp::Clip> {
+	using T                     = imp::Clip;
+	static constexpr auto value = object("name",
+	                                     &T::name,
+	                                     "hotkey",
+	                                     &T::hotkey,
+	                                     "tracks",
+	                                     &T::tracks);
+};
+
+static constexpr auto FILE_PATH = "clips.json";
+
+namespace imp {
+
+static float hermite(const float v0,
+                     const float v1,
+                     const float m0,
+                     const float m1,
+                     const float t) {
+	const float t2 = t * t;
+	const float t3 = t2 * t;
+	return (2.0F * t3 - 3.0F * t2 + 1.0F) * v0
+	       + (t3 - 2.0F * t2 + t) * m0
+	       + (-2.0F * t3 + 3.0F * t2) * v1
+	       + (t3 - t2) * m1;
+}
+
+// Catmull-Rom tangents scaled for uneven keyframe spacing.
+static float sampleCubic(const std::vector<Keyframe>& keyframes,
+                         const std::size_t            i,
+                         const float                  t) {
+	const Keyframe& k0   = keyframes[i];
+	const Keyframe& k1   = keyframes[i + 1];
+	const Keyframe& prev = i > 0 ? keyframes[i - 1] : k0;
+	const Keyframe& next = i + 2 < keyframes.size() ? keyframes[i + 2] : k1;
+	const float     span = k1.time - k0.time;
+
+	const float m0 = (k1.value - prev.value) / (k1.time - prev.time) * span;
+	const float m1 = (next.value - k0.value) / (next.time - k0.time) * span;
+	return hermite(k0.value, k1.value, m0, m1, t);
+}
+
+static bool sanitizeTrack(ClipTrack& track) {
+	std::erase_if(track.keyframes, [](const Keyframe& keyframe) {
+		return keyframe.time < 0.0F;
+	});
+	std::ranges::stable_sort(track.keyframes, {}, &Keyframe::time);
+	const auto duplicates =
+	    std::ranges::unique(track.keyframes, {}, &Keyframe::time);
+	track.keyframes.erase(duplicates.begin(), duplicates.end());
+	return !track.keyframes.empty();
+}
+
+std::optional<Clips> loadClips() {
+	std::ifstream file(FILE_PATH);
+	if (!file.is_open()) {
+		return std::nullopt;
+	}
+
+	std::string contents((std::istreambuf_iterator<char>(file)),
+	                     std::istreambuf_iterator<char>());
+	file.close();
+
+	Clips clips;
+	auto  error = glz::read_json(clips, contents);
+	if (error) {
+		SDL_LogWarn(SDL_LOG_CATEGORY_APPLICATION, "Failed to read %s", FILE_PATH);
+		return std::nullopt;
+	}
+	for (auto& clip : clips) {
+		std::erase_if(clip.tracks, [](ClipTrack& track) {
+			return !sanitizeTrack(track);
+		});
+	}
+	return clips;
+}
+
+float ClipPlayer::sample(const ClipTrack& track,
+                         std::size_t&     cursor,
+                         const float      time) {
+	const auto& keyframes = track.keyframes;
+	while (cursor + 1 < keyframes.size() && time >= keyframes[cursor + 1].time) {
+		++cursor;
+	}
+	const Keyframe& k0 = keyframes[cursor];
+	if (cursor + 1 == keyframes.size() || time <= k0.time) {
+		return k0.value;
+	}
+	const Keyframe& k1 = keyframes[cursor + 1];
+	const float     t  = (time - k0.time) / (k1.time - k0.time);
+	switch (track.interpolation) {
+		case Interpolation::LINEAR:
+			return k0.value + (k1.value - k0.value) * t;
+		case Interpolation::CUBIC:
+			return sampleCubic(keyframes, cursor, t);
+	}
+	return k0.value;
+}
+
+bool ClipPlayer::isPlaying(const Code code) const {
+	return std::ranges::any_of(_playbacks, [code](const Playback& playback) {
+		return playback.code == code;
+	});
+}
+
+ClipPlayer::ClipPlayer() :
+    _clips(),
+    _hotkeys(),
+    _playbacks(),
+    _released() {}
+
+const Clips& ClipPlayer::getClips() const {
+	return _clips;
+}
+
+void ClipPlayer::load(Clips clips) {
+	for (const auto& playback : _playbacks) {
+		_released.push_back(playback.code);
+	}
+	_playbacks.clear();
+	_clips = std::move(clips);
+	_hotkeys.clear();
+	for (const auto& clip : _clips) {
+		const auto code = findSymbol(clip.hotkey);
+		if (!clip.hotkey.empty() && !code) {
+			SDL_LogWarn(SDL_LOG_CATEGORY_APPLICATION,
+			            "Unknown hotkey %s for clip %s",
+			            clip.hotkey.c_str(),
+			            clip.name.c_str());
+		}
+		_hotkeys.push_back(code.value_or(0));
+	}
+}
+
+void ClipPlayer::play(const std::size_t clip) {
+	std::erase_if(_playbacks, [clip](const Playback& playback) {
+		return playback.clip == clip;
+	});
+	for (const auto& track : _clips[clip].tracks) {
+		_playbacks.push_back({.track  = &track,
+		                      .code   = makeClipCode(track.channel),
+		                      .time   = 0.0F,
+		                      .cursor = 0,
+		                      .clip   = clip});
+	}
+}
+
+bool ClipPlayer::trigger(const Code code) {
+	bool triggered = false;
+	for (std::size_t i = 0; i < _hotkeys.size(); ++i) {
+		if (_hotkeys[i] == code) {
+			play(i);
+			triggered = true;
+		}
+	}
+	return triggered;
+}
+
+}  // namespace imp
@@ -0,0 +1,193 @@
+#include "impulse/generator.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <numbers>
+#include <ranges>
+#include <span>
+#include <utility>
+#include <vector>
+
+#include <SDL3/SDL_stdinc.h>
+
+#include "impulse/code.hpp"
+
+namespace imp {
+
+static constexpr float BLINK_DURATION_S  = 0.15F;
+static constexpr float MIN_RATE_HZ       = 0.001F;
+static constexpr float NOISE_PHASE_CELLS = 256.0F;
+static constexpr float TWO_PI            = 2.0F * std::numbers::pi_v<float>;
+
+static constexpr Uint32 hash(Uint32 x) {
+	x ^= x >> 16;
+	x *= 0x7FEB352DU;
+	x ^= x >> 15;
+	x *= 0x846CA68BU;
+	x ^= x >> 16;
+	return x;
+}
+
+static constexpr float toUnit(const Uint32 x) {
+	return static_cast<float>(x >> 8) / static_cast<float>(1U << 24);
+}
+
+static float gradient(const Uint32 cell, const Uint32 seed) {
+	return toUnit(hash(cell ^ seed)) * 2.0F - 1.0F;
+}
+
+static float perlin(const Uint32 cell, const float t, const Uint32 seed) {
+	const float g0   = gradient(cell, seed) * t;
+	const float g1   = gradient(cell + 1, seed) * (t - 1.0F);
+	const float fade = t * t * t * (t * (t * 6.0F - 15.0F) + 10.0F);
+	return g0 + (g1 - g0) * fade;
+}
+
+static float sampleBlinkInterval(Uint32& seed, const float rate) {
+	seed          = hash(seed + 1);
+	const float u = toUnit(seed);
+	return std::max(-std::log1p(-u) / rate, BLINK_DURATION_S);
+}
+
+Waveform GeneratorBank::getWaveform(const std::size_t index) const {
+	if (index >= _blinkBegin) {
+		return Waveform::BLINK;
+	}
+	if (index >= _noiseBegin) {
+		return Waveform::NOISE;
+	}
+	if (index >= _triangleBegin) {
+		return Waveform::TRIANGLE;
+	}
+	return Waveform::SINE;
+}
+
+void GeneratorBank::advance(const float dtS) {
+	for (std::size_t i = 0; i < _blinkBegin; ++i) {
+		const float next  = _clocks[i] + _rates[i] * dtS;
+		const float whole = std::floor(next);
+		_cells[i] += static_cast<Uint32>(whole);
+		_clocks[i] = next - whole;
+	}
+}
+
+void GeneratorBank::evaluateBlinks(const float dtS) {
+	for (std::size_t i = _blinkBegin; i < _codes.size(); ++i) {
+		_clocks[i] -= dtS;
+		if (_clocks[i] <= -BLINK_DURATION_S) {
+			_clocks[i] += sampleBlinkInterval(_seeds[i], _rates[i]);
+		}
+		_outputs[i] = _clocks[i] <= 0.0F ? 1.0F : 0.0F;
+	}
+}
+
+void GeneratorBank::evaluateNoise() {
+	for (std::size_t i = _noiseBegin; i < _blinkBegin; ++i) {
+		const float  offset = _clocks[i] + _phases[i] * NOISE_PHASE_CELLS;
+		const float  whole  = std::floor(offset);
+		const Uint32 cell   = _cells[i] + static_cast<Uint32>(whole);
+		const float  value  = perlin(cell, offset - whole, _seeds[i]);
+		_outputs[i]         = std::clamp(0.5F + value, 0.0F, 1.0F);
+	}
+}
+
+void GeneratorBank::evaluateSines() {
+	for (std::size_t i = 0; i < _triangleBegin; ++i) {
+		_outputs[i] = 0.5F + 0.5F * std::sin(TWO_PI * (_clocks[i] + _phases[i]));
+	}
+}
+
+void GeneratorBank::evaluateTriangles() {
+	for (std::size_t i = _triangleBegin; i < _noiseBegin; ++i) {
+		const float t = _clocks[i] + _phases[i];
+		_outputs[i]   = 1.0F - std::abs(2.0F * (t - std::floor(t)) - 1.0F);
+	}
+}
+
+GeneratorBank::GeneratorBank() :
+    _codes(),
+    _rates(),
+    _phases(),
+    _clocks(),
+    _cells(),
+    _seeds(),
+    _outputs(),
+    _triangleBegin(0),
+    _noiseBegin(0),
+    _blinkBegin(0) {}
+
+std::span<const Code> GeneratorBank::codes() const {
+	return _codes;
+}
+
+std::span<const float> GeneratorBank::outputs() const {
+	return _outputs;
+}
+
+// A generator keeps its running state across reconfiguration only while its
+// waveform stays the same; the clock means something else to a blink than to
+// a sine, so one that changes waveform starts over as if it were new.
+void GeneratorBank::configure(const std::vector<GeneratorConfig>& configs) {
+	auto sorted = configs;
+	std::ranges::stable_sort(sorted, {}, &GeneratorConfig::waveform);
+
+	std::vector<Code>   codes;
+	std::vector<float>  rates;
+	std::vector<float>  phases;
+	std::vector<float>  clocks;
+	std::vector<Uint32> cells;
+	std::vector<Uint32> seeds;
+	std::vector<float>  outputs;
+	for (const auto& config : sorted) {
+		const Code  code  = makeGeneratorCode(config.id);
+		const float rate  = std::max(config.rate, MIN_RATE_HZ);
+		const auto  found = std::ranges::find(_codes, code);
+		const auto  i     = static_cast<std::size_t>(found - _codes.begin());
+		codes.push_back(code);
+		rates.push_back(rate);
+		phases.push_back(config.phase);
+		if (found != _codes.end() && getWaveform(i) == config.waveform) {
+			clocks.push_back(_clocks[i]);
+			cells.push_back(_cells[i]);
+			seeds.push_back(_seeds[i]);
+			outputs.push_back(_outputs[i]);
+			continue;
+		}
+		Uint32 seed = hash(code);
+		clocks.push_back(config.waveform == Waveform::BLINK
+		                     ? config.phase / rate
+		                           + sampleBlinkInterval(seed, rate)
+		                     : 0.0F);
+		cells.push_back(0);
+		seeds.push_back(seed);
+		outputs.push_back(0.0F);
+	}
+
+	const auto begin = [&sorted](const Waveform waveform) {
+		return static_cast<std::size_t>(
+		    std::ranges::lower_bound(sorted, waveform, {}, &GeneratorConfig::waveform)
+		    - sorted.begin());
+	};
+	_triangleBegin = begin(Waveform::TRIANGLE);
+	_noiseBegin    = begin(Waveform::NOISE);
+	_blinkBegin    = begin(Waveform::BLINK);
+
+	_codes   = std::move(codes);
+	_rates   = std::move(rates);
+	_phases  = std::move(phases);
+	_clocks  = std::move(clocks);
+	_cells   = std::move(cells);
+	_seeds   = std::move(seeds);
+	_outputs = std::move(outputs);
+}
+
+void GeneratorBank::update(const float dtS) {
+	advance(dtS);
+	evaluateSines();
+	evaluateTriangles();
+	evaluateNoise();
+	evaluateBlinks(dtS);
+}
+
+}  // namespace imp
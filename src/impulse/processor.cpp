@@ -14,7 +14,9 @@
 
 #include "core/settings.hpp"
 #include "core/utility.hpp"
+#include "impulse/clip.hpp"
 #include "impulse/code.hpp"
+#include "impulse/generator.hpp"
 #include "math/formula.hpp"
 #include "math/geometry.hpp"
 
@@ -157,24 +159,34 @@ void Processor::handleGamepadButton(SDL_GamepadButtonEvent& event,
 			code |= GamepadButton::RIGHT_STICK;
 			break;
 	}
+	if (isClicked) {
+		_clips.trigger(code);
+	}
 	_queue.emplace_back(code, isClicked ? 1.0F : 0.0F);
 }
 
 void Processor::handleKeyDown(SDL_UserEvent& event) {
 	auto         keycode = core::pointerToUnsigned<Uint32>(event.data1);
 	const Uint32 code    = EventTag::KEY | (keycode << 16);
+	if (_heldKeys.insert(code).second) {
+		_clips.trigger(code);
+	}
 	_queue.emplace_back(code, 1.0F);
 }
 
 void Processor::handleKeyUp(SDL_UserEvent& event) {
 	auto         keycode = core::pointerToUnsigned<Uint32>(event.data1);
 	const Uint32 code    = EventTag::KEY | (keycode << 16);
+	_heldKeys.erase(code);
 	_queue.emplace_back(code, 0.0F);
 }
 
 void Processor::handleMouseButton(SDL_UserEvent& event, bool isClicked) {
 	auto         button = core::pointerToUnsigned<Uint32>(event.data1);
 	const Uint32 code   = EventTag::MOUSE_BUTTON | button;
+	if (isClicked) {
+		_clips.trigger(code);
+	}
 	_queue.emplace_back(code, isClicked ? 1.0F : 0.0F);
 }
 
@@ -197,6 +209,37 @@ void Processor::handleMouseWheel(SDL_UserEvent& event) {
 	}
 }
 
+void Processor::configureGenerators(
+    const std::vector<GeneratorConfig>& generators) {
+	_generatorConfigs = generators;
+	_generators.configure(generators);
+	_generatorOutputs.assign(_generators.outputs().size(),
+	                         std::numeric_limits<float>::quiet_NaN());
+}
+
+static constexpr Uint64 MAX_GENERATOR_STEP_MS = 250;
+
+void Processor::updateClips(const Uint64 dtMs) {
+	const float dtS = std::min(dtMs, MAX_GENERATOR_STEP_MS) / 1000.0F;
+	_clips.update(dtS, [this](const Code code, const float value) {
+		_queue.emplace_back(code, value);
+	});
+}
+
+void Processor::updateGenerators(const Uint64 dtMs) {
+	const float dtS = std::min(dtMs, MAX_GENERATOR_STEP_MS) / 1000.0F;
+	_generators.update(dtS);
+
+	const auto codes   = _generators.codes();
+	const auto outputs = _generators.outputs();
+	for (size_t i = 0; i < codes.size(); ++i) {
+		if (outputs[i] != _generatorOutputs[i]) {
+			_generatorOutputs[i] = outputs[i];
+			_queue.emplace_back(codes[i], outputs[i]);
+		}
+	}
+}
+
 static constexpr float MOUSE_DECAY_RATE_PER_MS = .65F;
 static constexpr Code  MOUSE_MOVE_ABS_X = EventTag::MOUSE_MOVE_ABS | Axis::X;
 static constexpr Code  MOUSE_MOVE_ABS_Y = EventTag::MOUSE_MOVE_ABS | Axis::Y;
@@ -277,9 +320,20 @@ Processor::Processor() :
     _mouseBounds(SETTINGS.getMouseBounds()),
     _mouseState(),
     _lastUpdateTimeMs(0),
+    _generators(),
+    _generatorConfigs(),
+    _generatorOutputs(),
+    _clips(),
+    _heldKeys(),
     _queue() {
 	_mouseCoefficient = calcMouseCoefficient(_mouseSensitivity);
 	_queue.reserve(MAX_EXPECTED_IMPULSES);
+	configureGenerators(SETTINGS.getGenerators());
+	reloadClips();
+}
+
+const Clips& Processor::getClips() const {
+	return _clips.getClips();
 }
 
 const ImpulseQueue& Processor::impulses() const {
@@ -294,6 +348,10 @@ const MouseState& Processor::getMouseState() const {
 	return _mouseState;
 }
 
+const std::vector<GeneratorConfig>& Processor::getGenerators() const {
+	return _generatorConfigs;
+}
+
 int Processor::getMouseSensitivity() const {
 	return _mouseSensitivity;
 }
@@ -349,6 +407,15 @@ void Processor::handleEvent(SDL_UserEvent& event) {
 	}
 }
 
+void Processor::reloadClips() {
+	_clips.load(loadClips().value_or(Clips{}));
+}
+
+void Processor::setGenerators(const std::vector<GeneratorConfig>& generators) {
+	SETTINGS.setGenerators(generators);
+	configureGenerators(generators);
+}
+
 void Processor::setMouseBounds(const math::Rectangle<int>& bounds) {
 	if (bounds.top >= bounds.bottom || bounds.left >= bounds.right) {
 		return;
@@ -376,6 +443,8 @@ void Processor::setMouseSensitivity(const int sensitivity) {
 void Processor::update() {
 	const Uint64 timeMs = SDL_GetTicks();
 	const Uint64 dtMs   = timeMs - _lastUpdateTimeMs;
+	updateGenerators(dtMs);
+	updateClips(dtMs);
 	updateMouseMovement(dtMs);
 	updateMouseWheel(dtMs);
 	_lastUpdateTimeMs = timeMs;
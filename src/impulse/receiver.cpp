@@ -1,5 +1,7 @@
 #include "impulse/receiver.hpp"
 
+#include <cstddef>
+
 #include "impulse/code.hpp"
 
 namespace imp {
@@ -11,7 +13,8 @@ Receiver::Receiver(const Code code, const bool isInverted) :
     _inMin(0.0F),
     _outMax(1.0F),
     _outMin(0.0F),
-    _value(0.0F) {
+    _value(0.0F),
+    _lane(0) {
 	const EventTag::T event = code & 0xFFFF;
 	if ((event == EventTag::MOUSE_MOVE_REL)
 	    || (event == EventTag::GAMEPAD_STICK_RIGHT)
@@ -40,8 +43,16 @@ float Receiver::getValue() const {
 	return _isInverted ? _value * -1.0F : _value;
 }
 
-bool& Receiver::isInvertedRef() {
-	return _isInverted;
+std::size_t Receiver::getLane() const {
+	return _lane;
+}
+
+void Receiver::setInverted(const bool isInverted) {
+	_isInverted = isInverted;
+}
+
+void Receiver::setLane(const std::size_t lane) {
+	_lane = lane;
 }
 
 void Receiver::update(float value) {
@@ -0,0 +1,145 @@
+#include "impulse/symbol.hpp"
+
+#include <charconv>
+#include <optional>
+#include <string_view>
+#include <unordered_map>
+
+#include "libuiohook/uiohook.h"
+
+#include "impulse/clip.hpp"
+#include "impulse/code.hpp"
+#include "impulse/generator.hpp"
+
+namespace imp {
+
+static constexpr Code keyCode(const Uint32 keycode) {
+	return EventTag::KEY | (keycode << 16);
+}
+
+static constexpr Code padCode(const GamepadButton::T button) {
+	return EventTag::GAMEPAD_BUTTON | button;
+}
+
+static const std::unordered_map<std::string_view, Code> SYMBOLS = {
+    {"key_shift",      keyCode(VC_SHIFT_L)},
+    {"key_ctrl",       keyCode(VC_CONTROL_L)},
+    {"key_alt",        keyCode(VC_ALT_L)},
+    {"key_space",      keyCode(VC_SPACE)},
+    {"key_tab",        keyCode(VC_TAB)},
+    {"key_enter",      keyCode(VC_ENTER)},
+    {"key_escape",     keyCode(VC_ESCAPE)},
+    {"key_up",         keyCode(VC_UP)},
+    {"key_down",       keyCode(VC_DOWN)},
+    {"key_left",       keyCode(VC_LEFT)},
+    {"key_right",      keyCode(VC_RIGHT)},
+    {"key_a",          keyCode(VC_A)},
+    {"key_b",          keyCode(VC_B)},
+    {"key_c",          keyCode(VC_C)},
+    {"key_d",          keyCode(VC_D)},
+    {"key_e",          keyCode(VC_E)},
+    {"key_f",          keyCode(VC_F)},
+    {"key_g",          keyCode(VC_G)},
+    {"key_h",          keyCode(VC_H)},
+    {"key_i",          keyCode(VC_I)},
+    {"key_j",          keyCode(VC_J)},
+    {"key_k",          keyCode(VC_K)},
+    {"key_l",          keyCode(VC_L)},
+    {"key_m",          keyCode(VC_M)},
+    {"key_n",          keyCode(VC_N)},
+    {"key_o",          keyCode(VC_O)},
+    {"key_p",          keyCode(VC_P)},
+    {"key_q",          keyCode(VC_Q)},
+    {"key_r",          keyCode(VC_R)},
+    {"key_s",          keyCode(VC_S)},
+    {"key_t",          keyCode(VC_T)},
+    {"key_u",          keyCode(VC_U)},
+    {"key_v",          keyCode(VC_V)},
+    {"key_w",          keyCode(VC_W)},
+    {"key_x",          keyCode(VC_X)},
+    {"key_y",          keyCode(VC_Y)},
+    {"key_z",          keyCode(VC_Z)},
+    {"key_0",          keyCode(VC_0)},
+    {"key_1",          keyCode(VC_1)},
+    {"key_2",          keyCode(VC_2)},
+    {"key_3",          keyCode(VC_3)},
+    {"key_4",          keyCode(VC_4)},
+    {"key_5",          keyCode(VC_5)},
+    {"key_6",          keyCode(VC_6)},
+    {"key_7",          keyCode(VC_7)},
+    {"key_8",          keyCode(VC_8)},
+    {"key_9",          keyCode(VC_9)},
+    {"key_f1",         keyCode(VC_F1)},
+    {"key_f2",         keyCode(VC_F2)},
+    {"key_f3",         keyCode(VC_F3)},
+    {"key_f4",         keyCode(VC_F4)},
+    {"key_f5",         keyCode(VC_F5)},
+    {"key_f6",         keyCode(VC_F6)},
+    {"key_f7",         keyCode(VC_F7)},
+    {"key_f8",         keyCode(VC_F8)},
+    {"key_f9",         keyCode(VC_F9)},
+    {"key_f10",        keyCode(VC_F10)},
+    {"key_f11",        keyCode(VC_F11)},
+    {"key_f12",        keyCode(VC_F12)},
+    {"mouse.left",     EventTag::MOUSE_BUTTON | MouseButton::LEFT},
+    {"mouse.right",    EventTag::MOUSE_BUTTON | MouseButton::RIGHT},
+    {"mouse.middle",   EventTag::MOUSE_BUTTON | MouseButton::MIDDLE},
+    {"mouse.x",        EventTag::MOUSE_MOVE_ABS | Axis::X},
+    {"mouse.y",        EventTag::MOUSE_MOVE_ABS | Axis::Y},
+    {"mouse.dx",       EventTag::MOUSE_MOVE_REL | Axis::X},
+    {"mouse.dy",       EventTag::MOUSE_MOVE_REL | Axis::Y},
+    {"wheel.up",       EventTag::MOUSE_WHEEL | MouseWheel::UP},
+    {"wheel.down",     EventTag::MOUSE_WHEEL | MouseWheel::DOWN},
+    {"lstick.x",       EventTag::GAMEPAD_STICK_LEFT | Axis::X},
+    {"lstick.y",       EventTag::GAMEPAD_STICK_LEFT | Axis::Y},
+    {"rstick.x",       EventTag::GAMEPAD_STICK_RIGHT | Axis::X},
+    {"rstick.y",       EventTag::GAMEPAD_STICK_RIGHT | Axis::Y},
+    {"ltrigger",       EventTag::GAMEPAD_TRIGGER | Side::LEFT},
+    {"rtrigger",       EventTag::GAMEPAD_TRIGGER | Side::RIGHT},
+    {"pad.north",      padCode(GamepadButton::NORTH)},
+    {"pad.south",      padCode(GamepadButton::SOUTH)},
+    {"pad.west",       padCode(GamepadButton::WEST)},
+    {"pad.east",       padCode(GamepadButton::EAST)},
+    {"pad.lshoulder",  padCode(GamepadButton::LEFT_SHOULDER)},
+    {"pad.rshoulder",  padCode(GamepadButton::RIGHT_SHOULDER)},
+    {"pad.dpad.up",    padCode(GamepadButton::DPAD_UP)},
+    {"pad.dpad.down",  padCode(GamepadButton::DPAD_DOWN)},
+    {"pad.dpad.left",  padCode(GamepadButton::DPAD_LEFT)},
+    {"pad.dpad.right", padCode(GamepadButton::DPAD_RIGHT)},
+    {"pad.lstick",     padCode(GamepadButton::LEFT_STICK)},
+    {"pad.rstick",     padCode(GamepadButton::RIGHT_STICK)},
+};
+
+static constexpr std::string_view CLIP_PREFIX      = "clip.";
+static constexpr std::string_view GENERATOR_PREFIX = "gen.";
+
+static std::optional<Uint16> findIndex(const std::string_view name,
+                                       const std::string_view prefix) {
+	if (!name.starts_with(prefix)) {
+		return std::nullopt;
+	}
+	const auto  id    = name.substr(prefix.size());
+	Uint16      value = 0;
+	const auto* end   = id.data() + id.size();
+	const auto [ptr, ec] = std::from_chars(id.data(), end, value);
+	if (id.empty() || ec != std::errc{} || ptr != end) {
+		return std::nullopt;
+	}
+	return value;
+}
+
+std::optional<Code> findSymbol(const std::string_view name) {
+	const auto it = SYMBOLS.find(name);
+	if (it != SYMBOLS.end()) {
+		return it->second;
+	}
+	if (const auto id = findIndex(name, GENERATOR_PREFIX)) {
+		return makeGeneratorCode(*id);
+	}
+	if (const auto channel = findIndex(name, CLIP_PREFIX)) {
+		return makeClipCode(*channel);
+	}
+	return std::nullopt;
+}
+
+}  // namespace imp
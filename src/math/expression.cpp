@@ -0,0 +1,458 @@
+#include "math/expression.hpp"
+
+#include <algorithm>
+#include <array>
+#include <cctype>
+#include <charconv>
+#include <cmath>
+#include <cstddef>
+#include <expected>
+#include <format>
+#include <optional>
+#include <span>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+#include "math/formula.hpp"
+
+namespace math {
+
+struct ExpressionFunction {
+	std::string_view name;
+	OpCode           op;
+	std::size_t      arity;
+};
+
+static constexpr ExpressionFunction FUNCTIONS[] = {
+    {"abs",        OpCode::ABS,        1},
+    {"sign",       OpCode::SIGN,       1},
+    {"min",        OpCode::MIN,        2},
+    {"max",        OpCode::MAX,        2},
+    {"clamp",      OpCode::CLAMP,      3},
+    {"deadzone",   OpCode::DEADZONE,   2},
+    {"remap",      OpCode::REMAP,      5},
+    {"smoothstep", OpCode::SMOOTHSTEP, 3},
+};
+
+static float apply(const OpCode op, const float* a) {
+	switch (op) {
+		case OpCode::NEGATE:
+			return -a[0];
+		case OpCode::ADD:
+			return a[0] + a[1];
+		case OpCode::SUBTRACT:
+			return a[0] - a[1];
+		case OpCode::MULTIPLY:
+			return a[0] * a[1];
+		case OpCode::DIVIDE:
+			return a[1] == 0.0F ? 0.0F : a[0] / a[1];
+		case OpCode::LESS:
+			return a[0] < a[1] ? 1.0F : 0.0F;
+		case OpCode::LESS_EQUAL:
+			return a[0] <= a[1] ? 1.0F : 0.0F;
+		case OpCode::GREATER:
+			return a[0] > a[1] ? 1.0F : 0.0F;
+		case OpCode::GREATER_EQUAL:
+			return a[0] >= a[1] ? 1.0F : 0.0F;
+		case OpCode::EQUAL:
+			return a[0] == a[1] ? 1.0F : 0.0F;
+		case OpCode::NOT_EQUAL:
+			return a[0] != a[1] ? 1.0F : 0.0F;
+		case OpCode::SELECT:
+			return a[0] != 0.0F ? a[1] : a[2];
+		case OpCode::ABS:
+			return std::abs(a[0]);
+		case OpCode::SIGN:
+			return sign(a[0]);
+		case OpCode::MIN:
+			return std::min(a[0], a[1]);
+		case OpCode::MAX:
+			return std::max(a[0], a[1]);
+		case OpCode::CLAMP:
+			return std::clamp(a[0], std::min(a[1], a[2]), std::max(a[1], a[2]));
+		case OpCode::DEADZONE:
+			return deadzone(a[0], a[1]);
+		case OpCode::REMAP:
+			return remapLinear(a[0], a[1], a[2], a[3], a[4]);
+		case OpCode::SMOOTHSTEP:
+			return smoothstep(a[0], a[1], a[2]);
+		case OpCode::LOAD_CONSTANT:
+		case OpCode::LOAD_VARIABLE:
+			break;
+	}
+	return 0.0F;
+}
+
+struct ExpressionNode {
+	OpCode                      op;
+	float                       constant;
+	Uint16                      variable;
+	std::vector<ExpressionNode> args;
+};
+
+static ExpressionNode makeConstant(const float value) {
+	return {OpCode::LOAD_CONSTANT, value, 0, {}};
+}
+
+static ExpressionNode makeOperation(const OpCode                op,
+                                    std::vector<ExpressionNode>&& args) {
+	const bool isConstant = std::ranges::all_of(args, [](const auto& arg) {
+		return arg.op == OpCode::LOAD_CONSTANT;
+	});
+	if (!isConstant) {
+		return {op, 0.0F, 0, std::move(args)};
+	}
+	std::array<float, 8> operands{};
+	for (std::size_t i = 0; i < args.size(); ++i) {
+		operands[i] = args[i].constant;
+	}
+	return makeConstant(apply(op, operands.data()));
+}
+
+// Every nested parenthesis, call, conditional or unary sign recurses, so
+// nesting is capped well before the stack is at risk; deep input is
+// rejected here rather than by the register check once it has been parsed.
+class ExpressionParser {
+private:
+	static constexpr std::size_t MAX_NESTING = 64;
+
+	struct Nesting {
+		std::size_t& depth;
+
+		explicit Nesting(std::size_t& parserDepth) :
+		    depth(parserDepth) {
+			++depth;
+		}
+		Nesting(Nesting&)            = delete;
+		Nesting& operator=(Nesting&) = delete;
+		~Nesting() {
+			--depth;
+		}
+	};
+
+	std::string_view               _source;
+	std::size_t                    _position;
+	std::size_t                    _depth;
+	const SymbolResolver&          _resolve;
+	std::optional<ExpressionError> _error;
+
+	bool           accept(std::string_view token);
+	ExpressionNode fail(std::size_t position, std::string message);
+	ExpressionNode failNesting();
+	ExpressionNode parseAdditive();
+	ExpressionNode parseCall(std::string_view name, std::size_t position);
+	ExpressionNode parseComparison();
+	ExpressionNode parseConditional();
+	ExpressionNode parseIdentifier();
+	ExpressionNode parseMultiplicative();
+	ExpressionNode parseNumber();
+	ExpressionNode parsePrimary();
+	ExpressionNode parseUnary();
+	void           skipSpace();
+
+public:
+	ExpressionParser(std::string_view source, const SymbolResolver& resolve);
+
+	std::expected<ExpressionNode, ExpressionError> parse();
+};
+
+static bool isIdentifierStart(const char c) {
+	return (std::isalpha(static_cast<unsigned char>(c)) != 0) || c == '_';
+}
+
+static bool isIdentifierChar(const char c) {
+	return isIdentifierStart(c)
+	       || (std::isdigit(static_cast<unsigned char>(c)) != 0)
+	       || c == '.';
+}
+
+bool ExpressionParser::accept(const std::string_view token) {
+	skipSpace();
+	if (!_source.substr(_position).starts_with(token)) {
+		return false;
+	}
+	_position += token.size();
+	return true;
+}
+
+ExpressionNode ExpressionParser::fail(const std::size_t position,
+                                      std::string       message) {
+	if (!_error) {
+		_error = ExpressionError{position, std::move(message)};
+	}
+	return makeConstant(0.0F);
+}
+
+ExpressionNode ExpressionParser::failNesting() {
+	return fail(_position, "expression is nested too deeply");
+}
+
+ExpressionNode ExpressionParser::parseConditional() {
+	const Nesting nesting(_depth);
+	if (_depth > MAX_NESTING) {
+		return failNesting();
+	}
+	auto condition = parseComparison();
+	if (!accept("?")) {
+		return condition;
+	}
+	auto whenTrue = parseConditional();
+	if (!accept(":")) {
+		return fail(_position, "expected ':'");
+	}
+	auto                        whenFalse = parseConditional();
+	std::vector<ExpressionNode> args;
+	args.push_back(std::move(condition));
+	args.push_back(std::move(whenTrue));
+	args.push_back(std::move(whenFalse));
+	return makeOperation(OpCode::SELECT, std::move(args));
+}
+
+ExpressionNode ExpressionParser::parseComparison() {
+	static constexpr std::pair<std::string_view, OpCode> OPERATORS[] = {
+	    {"<=", OpCode::LESS_EQUAL   },
+	    {">=", OpCode::GREATER_EQUAL},
+	    {"==", OpCode::EQUAL        },
+	    {"!=", OpCode::NOT_EQUAL    },
+	    {"<",  OpCode::LESS         },
+	    {">",  OpCode::GREATER      },
+	};
+	auto lhs = parseAdditive();
+	for (const auto& [token, op] : OPERATORS) {
+		if (accept(token)) {
+			std::vector<ExpressionNode> args;
+			args.push_back(std::move(lhs));
+			args.push_back(parseAdditive());
+			return makeOperation(op, std::move(args));
+		}
+	}
+	return lhs;
+}
+
+ExpressionNode ExpressionParser::parseAdditive() {
+	auto lhs = parseMultiplicative();
+	while (true) {
+		OpCode op = OpCode::ADD;
+		if (accept("+")) {
+			op = OpCode::ADD;
+		}
+		else if (accept("-")) {
+			op = OpCode::SUBTRACT;
+		}
+		else {
+			return lhs;
+		}
+		std::vector<ExpressionNode> args;
+		args.push_back(std::move(lhs));
+		args.push_back(parseMultiplicative());
+		lhs = makeOperation(op, std::move(args));
+	}
+}
+
+ExpressionNode ExpressionParser::parseMultiplicative() {
+	auto lhs = parseUnary();
+	while (true) {
+		OpCode op = OpCode::MULTIPLY;
+		if (accept("*")) {
+			op = OpCode::MULTIPLY;
+		}
+		else if (accept("/")) {
+			op = OpCode::DIVIDE;
+		}
+		else {
+			return lhs;
+		}
+		std::vector<ExpressionNode> args;
+		args.push_back(std::move(lhs));
+		args.push_back(parseUnary());
+		lhs = makeOperation(op, std::move(args));
+	}
+}
+
+ExpressionNode ExpressionParser::parseUnary() {
+	const Nesting nesting(_depth);
+	if (_depth > MAX_NESTING) {
+		return failNesting();
+	}
+	if (accept("-")) {
+		std::vector<ExpressionNode> args;
+		args.push_back(parseUnary());
+		return makeOperation(OpCode::NEGATE, std::move(args));
+	}
+	if (accept("+")) {
+		return parseUnary();
+	}
+	return parsePrimary();
+}
+
+ExpressionNode ExpressionParser::parsePrimary() {
+	skipSpace();
+	if (_position >= _source.size()) {
+		return fail(_position, "unexpected end of expression");
+	}
+	if (accept("(")) {
+		auto inner = parseConditional();
+		if (!accept(")")) {
+			return fail(_position, "expected ')'");
+		}
+		return inner;
+	}
+	const char c = _source[_position];
+	if ((std::isdigit(static_cast<unsigned char>(c)) != 0) || c == '.') {
+		return parseNumber();
+	}
+	if (isIdentifierStart(c)) {
+		return parseIdentifier();
+	}
+	return fail(_position, std::format("unexpected '{}'", c));
+}
+
+ExpressionNode ExpressionParser::parseNumber() {
+	const char* begin = _source.data() + _position;
+	const char* end   = _source.data() + _source.size();
+	float       value = 0.0F;
+	const auto [next, error] = std::from_chars(begin, end, value);
+	if (error != std::errc()) {
+		return fail(_position, "invalid number");
+	}
+	_position += next - begin;
+	return makeConstant(value);
+}
+
+ExpressionNode ExpressionParser::parseIdentifier() {
+	const std::size_t start = _position;
+	while (_position < _source.size() && isIdentifierChar(_source[_position])) {
+		++_position;
+	}
+	const auto name = _source.substr(start, _position - start);
+	if (accept("(")) {
+		return parseCall(name, start);
+	}
+	const auto variable = _resolve(name);
+	if (!variable || *variable > UINT16_MAX) {
+		return fail(start, std::format("unknown input '{}'", name));
+	}
+	return {OpCode::LOAD_VARIABLE, 0.0F, static_cast<Uint16>(*variable), {}};
+}
+
+ExpressionNode ExpressionParser::parseCall(const std::string_view name,
+                                           const std::size_t      position) {
+	const auto* function = std::ranges::find(FUNCTIONS,
+	                                         name,
+	                                         &ExpressionFunction::name);
+	if (function == std::ranges::end(FUNCTIONS)) {
+		return fail(position, std::format("unknown function '{}'", name));
+	}
+	std::vector<ExpressionNode> args;
+	if (!accept(")")) {
+		do {
+			args.push_back(parseConditional());
+		} while (!_error && accept(","));
+		if (!accept(")")) {
+			return fail(_position, "expected ')'");
+		}
+	}
+	if (args.size() != function->arity) {
+		return fail(position,
+		            std::format("'{}' takes {} argument(s)", name, function->arity));
+	}
+	return makeOperation(function->op, std::move(args));
+}
+
+void ExpressionParser::skipSpace() {
+	while (_position < _source.size()
+	       && (std::isspace(static_cast<unsigned char>(_source[_position]))
+	           != 0)) {
+		++_position;
+	}
+}
+
+ExpressionParser::ExpressionParser(const std::string_view source,
+                                   const SymbolResolver&  resolve) :
+    _source(source),
+    _position(0),
+    _depth(0),
+    _resolve(resolve),
+    _error() {}
+
+std::expected<ExpressionNode, ExpressionError> ExpressionParser::parse() {
+	auto root = parseConditional();
+	skipSpace();
+	if (!_error && _position < _source.size()) {
+		fail(_position, std::format("unexpected '{}'", _source[_position]));
+	}
+	if (_error) {
+		return std::unexpected(*_error);
+	}
+	return root;
+}
+
+static bool emit(const ExpressionNode&     node,
+                 const std::size_t         reg,
+                 std::vector<Instruction>& program) {
+	if (reg + node.args.size() >= Expression::MAX_REGISTERS) {
+		return false;
+	}
+	for (std::size_t i = 0; i < node.args.size(); ++i) {
+		if (!emit(node.args[i], reg + i, program)) {
+			return false;
+		}
+	}
+	program.push_back({.op       = node.op,
+	                   .reg      = static_cast<Uint8>(reg),
+	                   .variable = node.variable,
+	                   .constant = node.constant});
+	return true;
+}
+
+Expression::Expression() :
+    _program() {}
+
+std::expected<Expression, ExpressionError> Expression::compile(
+    const std::string_view source,
+    const SymbolResolver&  resolve) {
+	ExpressionParser parser(source, resolve);
+	auto             root = parser.parse();
+	if (!root) {
+		return std::unexpected(root.error());
+	}
+	Expression expression;
+	if (!emit(*root, 0, expression._program)) {
+		return std::unexpected(
+		    ExpressionError{0, "expression is nested too deeply"});
+	}
+	return expression;
+}
+
+bool Expression::isEmpty() const {
+	return _program.empty();
+}
+
+float Expression::evaluate(const std::span<const float> variables) const {
+	std::array<float, MAX_REGISTERS> registers{};
+	for (const auto& instruction : _program) {
+		float* operands = registers.data() + instruction.reg;
+		switch (instruction.op) {
+			case OpCode::LOAD_CONSTANT:
+				operands[0] = instruction.constant;
+				break;
+			case OpCode::LOAD_VARIABLE:
+				operands[0] = instruction.variable < variables.size()
+				                  ? variables[instruction.variable]
+				                  : 0.0F;
+				break;
+			default:
+				operands[0] = apply(instruction.op, operands);
+				break;
+		}
+	}
+	return registers[0];
+}
+
+std::size_t Expression::size() const {
+	return _program.size();
+}
+
+}  // namespace math
@@ -0,0 +1,429 @@
+#include "math/reduce.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <limits>
+#include <span>
+
+#include <SDL3/SDL_cpuinfo.h>
+
+#if defined(__x86_64__) || defined(_M_X64) || defined(__i386__) \
+    || defined(_M_IX86)
+#define MATH_REDUCE_X86 1
+#include <immintrin.h>
+#elif defined(__aarch64__) || defined(_M_ARM64)
+#define MATH_REDUCE_NEON 1
+#include <arm_neon.h>
+#endif
+
+#if defined(__GNUC__) || defined(__clang__)
+#define MATH_TARGET(isa) __attribute__((target(isa)))
+#else
+#define MATH_TARGET(isa)
+#endif
+
+static constexpr float LOWEST = std::numeric_limits<float>::lowest();
+
+// The major value is the one furthest from the origin, preferring the larger
+// value on ties. A zero spread falls back to the original running value of 0.
+static float resolveMajor(const float candidate, const float majorDelta) {
+	return majorDelta == 0.0F ? std::max(0.0F, candidate) : candidate;
+}
+
+static float sumScalar(const float* values, const size_t n) {
+	float total = 0.0F;
+	for (size_t i = 0; i < n; ++i) {
+		total += values[i];
+	}
+	return total;
+}
+
+static float maxScalar(const float* values, const size_t n, float initial) {
+	for (size_t i = 0; i < n; ++i) {
+		initial = std::max(initial, values[i]);
+	}
+	return initial;
+}
+
+static float minScalar(const float* values, const size_t n, float initial) {
+	for (size_t i = 0; i < n; ++i) {
+		initial = std::min(initial, values[i]);
+	}
+	return initial;
+}
+
+static float majorScalar(const float* values,
+                         const size_t n,
+                         const float  origin) {
+	float majorValue = 0.0F;
+	float majorDelta = 0.0F;
+	for (size_t i = 0; i < n; ++i) {
+		const float delta = std::abs(values[i] - origin);
+		if ((delta > majorDelta) || (delta == majorDelta && values[i] > majorValue)) {
+			majorValue = values[i];
+			majorDelta = delta;
+		}
+	}
+	return majorValue;
+}
+
+#ifdef MATH_REDUCE_X86
+
+MATH_TARGET("sse4.1")
+static float horizontalSum(const __m128 v) {
+	__m128 shuffled = _mm_movehdup_ps(v);
+	__m128 sums     = _mm_add_ps(v, shuffled);
+	shuffled        = _mm_movehl_ps(shuffled, sums);
+	sums            = _mm_add_ss(sums, shuffled);
+	return _mm_cvtss_f32(sums);
+}
+
+MATH_TARGET("sse4.1")
+static float horizontalMax(const __m128 v) {
+	__m128 folded = _mm_max_ps(v, _mm_movehl_ps(v, v));
+	folded        = _mm_max_ss(folded, _mm_movehdup_ps(folded));
+	return _mm_cvtss_f32(folded);
+}
+
+MATH_TARGET("sse4.1")
+static float horizontalMin(const __m128 v) {
+	__m128 folded = _mm_min_ps(v, _mm_movehl_ps(v, v));
+	folded        = _mm_min_ss(folded, _mm_movehdup_ps(folded));
+	return _mm_cvtss_f32(folded);
+}
+
+MATH_TARGET("sse4.1")
+static __m128 absSse(const __m128 v) {
+	return _mm_andnot_ps(_mm_set1_ps(-0.0F), v);
+}
+
+MATH_TARGET("sse4.1")
+static float sumSse(const float* values, const size_t n) {
+	__m128 acc = _mm_setzero_ps();
+	size_t i   = 0;
+	for (; i + 4 <= n; i += 4) {
+		acc = _mm_add_ps(acc, _mm_loadu_ps(values + i));
+	}
+	return horizontalSum(acc) + sumScalar(values + i, n - i);
+}
+
+MATH_TARGET("sse4.1")
+static float maxSse(const float* values, const size_t n, const float initial) {
+	__m128 acc = _mm_set1_ps(initial);
+	size_t i   = 0;
+	for (; i + 4 <= n; i += 4) {
+		acc = _mm_max_ps(acc, _mm_loadu_ps(values + i));
+	}
+	return maxScalar(values + i, n - i, horizontalMax(acc));
+}
+
+MATH_TARGET("sse4.1")
+static float minSse(const float* values, const size_t n, const float initial) {
+	__m128 acc = _mm_set1_ps(initial);
+	size_t i   = 0;
+	for (; i + 4 <= n; i += 4) {
+		acc = _mm_min_ps(acc, _mm_loadu_ps(values + i));
+	}
+	return minScalar(values + i, n - i, horizontalMin(acc));
+}
+
+MATH_TARGET("sse4.1")
+static float majorSse(const float* values, const size_t n, const float origin) {
+	if (n == 0) {
+		return 0.0F;
+	}
+	const __m128 vOrigin = _mm_set1_ps(origin);
+
+	__m128 deltas = _mm_setzero_ps();
+	size_t i      = 0;
+	for (; i + 4 <= n; i += 4) {
+		const __m128 v = _mm_loadu_ps(values + i);
+		deltas         = _mm_max_ps(deltas, absSse(_mm_sub_ps(v, vOrigin)));
+	}
+	float majorDelta = horizontalMax(deltas);
+	for (size_t j = i; j < n; ++j) {
+		majorDelta = std::max(majorDelta, std::abs(values[j] - origin));
+	}
+
+	const __m128 vMajorDelta = _mm_set1_ps(majorDelta);
+	const __m128 vLowest     = _mm_set1_ps(LOWEST);
+
+	__m128 candidates = vLowest;
+	for (i = 0; i + 4 <= n; i += 4) {
+		const __m128 v       = _mm_loadu_ps(values + i);
+		const __m128 delta   = absSse(_mm_sub_ps(v, vOrigin));
+		const __m128 isMajor = _mm_cmpeq_ps(delta, vMajorDelta);
+		candidates = _mm_max_ps(candidates, _mm_blendv_ps(vLowest, v, isMajor));
+	}
+	float candidate = horizontalMax(candidates);
+	for (size_t j = i; j < n; ++j) {
+		if (std::abs(values[j] - origin) == majorDelta) {
+			candidate = std::max(candidate, values[j]);
+		}
+	}
+	return resolveMajor(candidate, majorDelta);
+}
+
+MATH_TARGET("avx2")
+static __m128 foldSumAvx(const __m256 v) {
+	__m128 folded =
+	    _mm_add_ps(_mm256_castps256_ps128(v), _mm256_extractf128_ps(v, 1));
+	folded        = _mm_add_ps(folded, _mm_movehl_ps(folded, folded));
+	return _mm_add_ss(folded, _mm_movehdup_ps(folded));
+}
+
+MATH_TARGET("avx2")
+static __m128 foldMaxAvx(const __m256 v) {
+	__m128 folded =
+	    _mm_max_ps(_mm256_castps256_ps128(v), _mm256_extractf128_ps(v, 1));
+	folded        = _mm_max_ps(folded, _mm_movehl_ps(folded, folded));
+	return _mm_max_ss(folded, _mm_movehdup_ps(folded));
+}
+
+MATH_TARGET("avx2")
+static __m128 foldMinAvx(const __m256 v) {
+	__m128 folded =
+	    _mm_min_ps(_mm256_castps256_ps128(v), _mm256_extractf128_ps(v, 1));
+	folded        = _mm_min_ps(folded, _mm_movehl_ps(folded, folded));
+	return _mm_min_ss(folded, _mm_movehdup_ps(folded));
+}
+
+MATH_TARGET("avx2")
+static __m256 absAvx(const __m256 v) {
+	return _mm256_andnot_ps(_mm256_set1_ps(-0.0F), v);
+}
+
+// The AVX kernels handle their own tails so that no legacy SSE code runs while
+// the upper halves of the registers are dirty.
+MATH_TARGET("avx2")
+static float sumAvx(const float* values, const size_t n) {
+	__m256 acc = _mm256_setzero_ps();
+	size_t i   = 0;
+	for (; i + 8 <= n; i += 8) {
+		acc = _mm256_add_ps(acc, _mm256_loadu_ps(values + i));
+	}
+	float total = _mm_cvtss_f32(foldSumAvx(acc));
+	for (; i < n; ++i) {
+		total += values[i];
+	}
+	return total;
+}
+
+MATH_TARGET("avx2")
+static float maxAvx(const float* values, const size_t n, const float initial) {
+	__m256 acc = _mm256_set1_ps(initial);
+	size_t i   = 0;
+	for (; i + 8 <= n; i += 8) {
+		acc = _mm256_max_ps(acc, _mm256_loadu_ps(values + i));
+	}
+	float result = _mm_cvtss_f32(foldMaxAvx(acc));
+	for (; i < n; ++i) {
+		result = std::max(result, values[i]);
+	}
+	return result;
+}
+
+MATH_TARGET("avx2")
+static float minAvx(const float* values, const size_t n, const float initial) {
+	__m256 acc = _mm256_set1_ps(initial);
+	size_t i   = 0;
+	for (; i + 8 <= n; i += 8) {
+		acc = _mm256_min_ps(acc, _mm256_loadu_ps(values + i));
+	}
+	float result = _mm_cvtss_f32(foldMinAvx(acc));
+	for (; i < n; ++i) {
+		result = std::min(result, values[i]);
+	}
+	return result;
+}
+
+MATH_TARGET("avx2")
+static float majorAvx(const float* values, const size_t n, const float origin) {
+	if (n == 0) {
+		return 0.0F;
+	}
+	const __m256 vOrigin = _mm256_set1_ps(origin);
+
+	__m256 deltas = _mm256_setzero_ps();
+	size_t i      = 0;
+	for (; i + 8 <= n; i += 8) {
+		const __m256 v = _mm256_loadu_ps(values + i);
+		deltas         = _mm256_max_ps(deltas, absAvx(_mm256_sub_ps(v, vOrigin)));
+	}
+	float majorDelta = _mm_cvtss_f32(foldMaxAvx(deltas));
+	for (size_t j = i; j < n; ++j) {
+		majorDelta = std::max(majorDelta, std::abs(values[j] - origin));
+	}
+
+	const __m256 vMajorDelta = _mm256_set1_ps(majorDelta);
+	const __m256 vLowest     = _mm256_set1_ps(LOWEST);
+
+	__m256 candidates = vLowest;
+	for (i = 0; i + 8 <= n; i += 8) {
+		const __m256 v       = _mm256_loadu_ps(values + i);
+		const __m256 delta   = absAvx(_mm256_sub_ps(v, vOrigin));
+		const __m256 isMajor = _mm256_cmp_ps(delta, vMajorDelta, _CMP_EQ_OQ);
+		candidates =
+		    _mm256_max_ps(candidates, _mm256_blendv_ps(vLowest, v, isMajor));
+	}
+	float candidate = _mm_cvtss_f32(foldMaxAvx(candidates));
+	for (size_t j = i; j < n; ++j) {
+		if (std::abs(values[j] - origin) == majorDelta) {
+			candidate = std::max(candidate, values[j]);
+		}
+	}
+	return resolveMajor(candidate, majorDelta);
+}
+
+#endif  // MATH_REDUCE_X86
+
+#ifdef MATH_REDUCE_NEON
+
+static float sumNeon(const float* values, const size_t n) {
+	float32x4_t acc = vdupq_n_f32(0.0F);
+	size_t      i   = 0;
+	for (; i + 4 <= n; i += 4) {
+		acc = vaddq_f32(acc, vld1q_f32(values + i));
+	}
+	return vaddvq_f32(acc) + sumScalar(values + i, n - i);
+}
+
+static float maxNeon(const float* values, const size_t n, const float initial) {
+	float32x4_t acc = vdupq_n_f32(initial);
+	size_t      i   = 0;
+	for (; i + 4 <= n; i += 4) {
+		acc = vmaxq_f32(acc, vld1q_f32(values + i));
+	}
+	return maxScalar(values + i, n - i, vmaxvq_f32(acc));
+}
+
+static float minNeon(const float* values, const size_t n, const float initial) {
+	float32x4_t acc = vdupq_n_f32(initial);
+	size_t      i   = 0;
+	for (; i + 4 <= n; i += 4) {
+		acc = vminq_f32(acc, vld1q_f32(values + i));
+	}
+	return minScalar(values + i, n - i, vminvq_f32(acc));
+}
+
+static float majorNeon(const float* values,
+                       const size_t n,
+                       const float  origin) {
+	if (n == 0) {
+		return 0.0F;
+	}
+	const float32x4_t vOrigin = vdupq_n_f32(origin);
+
+	float32x4_t deltas = vdupq_n_f32(0.0F);
+	size_t      i      = 0;
+	for (; i + 4 <= n; i += 4) {
+		const float32x4_t v = vld1q_f32(values + i);
+		deltas              = vmaxq_f32(deltas, vabdq_f32(v, vOrigin));
+	}
+	float majorDelta = vmaxvq_f32(deltas);
+	for (size_t j = i; j < n; ++j) {
+		majorDelta = std::max(majorDelta, std::abs(values[j] - origin));
+	}
+
+	const float32x4_t vMajorDelta = vdupq_n_f32(majorDelta);
+	const float32x4_t vLowest     = vdupq_n_f32(LOWEST);
+
+	float32x4_t candidates = vLowest;
+	for (i = 0; i + 4 <= n; i += 4) {
+		const float32x4_t v       = vld1q_f32(values + i);
+		const uint32x4_t  isMajor = vceqq_f32(vabdq_f32(v, vOrigin), vMajorDelta);
+		candidates = vmaxq_f32(candidates, vbslq_f32(isMajor, v, vLowest));
+	}
+	float candidate = vmaxvq_f32(candidates);
+	for (size_t j = i; j < n; ++j) {
+		if (std::abs(values[j] - origin) == majorDelta) {
+			candidate = std::max(candidate, values[j]);
+		}
+	}
+	return resolveMajor(candidate, majorDelta);
+}
+
+#endif  // MATH_REDUCE_NEON
+
+namespace math {
+
+static constexpr ReduceKernels SCALAR_KERNELS{
+    .name  = "Scalar",
+    .sum   = sumScalar,
+    .max   = maxScalar,
+    .min   = minScalar,
+    .major = majorScalar,
+};
+
+#ifdef MATH_REDUCE_X86
+static constexpr ReduceKernels SSE_KERNELS{
+    .name  = "SSE4.1",
+    .sum   = sumSse,
+    .max   = maxSse,
+    .min   = minSse,
+    .major = majorSse,
+};
+
+static constexpr ReduceKernels AVX_KERNELS{
+    .name  = "AVX2",
+    .sum   = sumAvx,
+    .max   = maxAvx,
+    .min   = minAvx,
+    .major = majorAvx,
+};
+#endif
+
+#ifdef MATH_REDUCE_NEON
+static constexpr ReduceKernels NEON_KERNELS{
+    .name  = "NEON",
+    .sum   = sumNeon,
+    .max   = maxNeon,
+    .min   = minNeon,
+    .major = majorNeon,
+};
+#endif
+
+static const ReduceKernels& selectKernels() {
+#ifdef MATH_REDUCE_X86
+	if (SDL_HasAVX2()) {
+		return AVX_KERNELS;
+	}
+	if (SDL_HasSSE41()) {
+		return SSE_KERNELS;
+	}
+#endif
+#ifdef MATH_REDUCE_NEON
+	if (SDL_HasNEON()) {
+		return NEON_KERNELS;
+	}
+#endif
+	return SCALAR_KERNELS;
+}
+
+const ReduceKernels& scalarReduceKernels() {
+	return SCALAR_KERNELS;
+}
+
+const ReduceKernels& reduceKernels() {
+	static const ReduceKernels& kernels = selectKernels();
+	return kernels;
+}
+
+float reduceSum(const std::span<const float> values) {
+	return reduceKernels().sum(values.data(), values.size());
+}
+
+float reduceMax(const std::span<const float> values, const float initial) {
+	return reduceKernels().max(values.data(), values.size(), initial);
+}
+
+float reduceMin(const std::span<const float> values, const float initial) {
+	return reduceKernels().min(values.data(), values.size(), initial);
+}
+
+float reduceMajor(const std::span<const float> values, const float origin) {
+	return reduceKernels().major(values.data(), values.size(), origin);
+}
+
+}  // namespace math
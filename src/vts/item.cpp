@@ -0,0 +1,110 @@
+#include "vts/item.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <iterator>
+#include <optional>
+#include <string>
+
+#include <SDL3/SDL_stdinc.h>
+
+#include "impulse/code.hpp"
+#include "vts/parameter.hpp"
+#include "vts/request.hpp"
+
+namespace vts {
+
+static constexpr const char* CHANNEL_NAMES[] = {
+    "positionX",
+    "positionY",
+    "rotation",
+    "size",
+};
+
+static_assert(std::size(CHANNEL_NAMES) == N_ITEM_CHANNELS);
+
+static constexpr std::size_t toIndex(const ItemChannel channel) {
+	return static_cast<std::size_t>(channel);
+}
+
+ItemBinding::ItemBinding(const std::string& fileName) :
+    _fileName(fileName),
+    _instanceId(),
+    _channels(),
+    _ranges(),
+    _changed(0) {
+	for (std::size_t i = 0; i < N_ITEM_CHANNELS; ++i) {
+		_channels[i].setName(CHANNEL_NAMES[i]);
+	}
+}
+
+float ItemBinding::getValue(const std::size_t channel) const {
+	const auto& parameter = _channels[channel];
+	const float t         = std::clamp(parameter.getNormalized(), 0.0F, 1.0F);
+	const auto& range     = _ranges[channel];
+	return std::lerp(range.low, range.high, std::isfinite(t) ? t : 0.0F);
+}
+
+const std::string& ItemBinding::getFileName() const {
+	return _fileName;
+}
+
+const std::string& ItemBinding::getInstanceId() const {
+	return _instanceId;
+}
+
+Parameter& ItemBinding::getChannel(const ItemChannel channel) {
+	return _channels[toIndex(channel)];
+}
+
+bool ItemBinding::isBound() const {
+	return !_instanceId.empty();
+}
+
+bool ItemBinding::handleImpulse(const imp::Code code, const float value) {
+	bool isChanged = false;
+	for (std::size_t i = 0; i < N_ITEM_CHANNELS; ++i) {
+		if (_channels[i].handleImpulse(code, value)) {
+			_changed |= 1U << i;
+			isChanged = true;
+		}
+	}
+	return isChanged;
+}
+
+ItemMove ItemBinding::takeMove() {
+	using enum ItemChannel;
+
+	const auto pick = [this](const ItemChannel channel) -> std::optional<float> {
+		const std::size_t i = toIndex(channel);
+		if ((_changed & (1U << i)) == 0) {
+			return std::nullopt;
+		}
+		return getValue(i);
+	};
+	const ItemMove move{.itemInstanceId = _instanceId,
+	                    .positionX      = pick(POSITION_X),
+	                    .positionY      = pick(POSITION_Y),
+	                    .rotation       = pick(ROTATION),
+	                    .size           = pick(SIZE)};
+	_changed = 0;
+	return move;
+}
+
+// A freshly loaded instance sits wherever VTS put it, so every driven channel
+// is sent again.
+void ItemBinding::setInstanceId(const std::string& instanceId) {
+	_instanceId = instanceId;
+	for (std::size_t i = 0; i < N_ITEM_CHANNELS; ++i) {
+		if (_channels[i].hasImpulses()) {
+			_changed |= 1U << i;
+		}
+	}
+}
+
+void ItemBinding::setRange(const ItemChannel channel, const ItemRange range) {
+	_ranges[toIndex(channel)] = range;
+}
+
+}  // namespace vts
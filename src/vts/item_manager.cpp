@@ -0,0 +1,85 @@
+#include "vts/item_manager.hpp"
+
+#include <cstddef>
+#include <span>
+#include <string>
+
+#include "impulse/code.hpp"
+#include "vts/item.hpp"
+#include "vts/request.hpp"
+
+namespace vts {
+
+ItemManager::ItemManager() :
+    _items(),
+    _dirty(),
+    _moves() {}
+
+bool ItemManager::isEmpty() const {
+	return _items.empty();
+}
+
+ItemBinding& ItemManager::add(const std::string& fileName) {
+	_dirty.resize(_items.size() + 1);
+	return _items.emplace_back(fileName);
+}
+
+// Binds the first unbound item configured for the instance's file, so two
+// bindings for the same file follow two copies of it.
+void ItemManager::bind(const ItemInstance& instance) {
+	for (std::size_t i = 0; i < _items.size(); ++i) {
+		auto& item = _items[i];
+		if (item.isBound() || item.getFileName() != instance.fileName) {
+			continue;
+		}
+		item.setInstanceId(instance.instanceId);
+		_dirty.set(i);
+		return;
+	}
+}
+
+void ItemManager::bindAll(const std::span<const ItemInstance> instances) {
+	for (auto& item : _items) {
+		item.setInstanceId({});
+	}
+	for (const auto& instance : instances) {
+		bind(instance);
+	}
+}
+
+void ItemManager::clear() {
+	_items.clear();
+	_dirty.resize(0);
+	_moves.clear();
+}
+
+// Changes to an unbound item are dropped; binding it sends every driven
+// channel anyway.
+std::span<const ItemMove> ItemManager::collectMoves() {
+	_moves.clear();
+	_dirty.drain([this](const std::size_t index) {
+		auto& item = _items[index];
+		if (item.isBound()) {
+			_moves.push_back(item.takeMove());
+		}
+	});
+	return _moves;
+}
+
+void ItemManager::distributeImpulse(const imp::Code code, const float value) {
+	for (std::size_t i = 0; i < _items.size(); ++i) {
+		if (_items[i].handleImpulse(code, value)) {
+			_dirty.set(i);
+		}
+	}
+}
+
+void ItemManager::unbind(const std::string& instanceId) {
+	for (auto& item : _items) {
+		if (item.getInstanceId() == instanceId) {
+			item.setInstanceId({});
+		}
+	}
+}
+
+}  // namespace vts
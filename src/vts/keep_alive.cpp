@@ -0,0 +1,56 @@
+#include "vts/keep_alive.hpp"
+
+#include <algorithm>
+#include <cstddef>
+
+#include <SDL3/SDL_stdinc.h>
+
+namespace vts {
+
+static constexpr Uint64 KEEP_ALIVE_INTERVAL_NS = SDL_MS_TO_NS(500);
+
+// The cursor comes back to each index once per interval. Skipping only values
+// sent within half of that keeps the worst gap between sends near 750 ms,
+// safely inside VTS's one-second parameter timeout.
+static constexpr Uint64 KEEP_ALIVE_STALE_NS = KEEP_ALIVE_INTERVAL_NS / 2;
+
+std::size_t KeepAlive::takeBudget(const Uint64 nowNs) {
+	if (_lastSentNs.empty()) {
+		_lastTickNs = nowNs;
+		return 0;
+	}
+	const Uint64 elapsedNs = std::min(nowNs - _lastTickNs, _intervalNs);
+	_lastTickNs            = nowNs;
+	_credit += static_cast<double>(_lastSentNs.size())
+	           * static_cast<double>(elapsedNs)
+	           / static_cast<double>(_intervalNs);
+	const auto budget = static_cast<std::size_t>(_credit);
+	_credit -= static_cast<double>(budget);
+	return std::min(budget, _lastSentNs.size());
+}
+
+KeepAlive::KeepAlive() :
+    _intervalNs(KEEP_ALIVE_INTERVAL_NS),
+    _staleNs(KEEP_ALIVE_STALE_NS),
+    _lastTickNs(0),
+    _credit(0.0),
+    _cursor(0),
+    _lastSentNs() {}
+
+void KeepAlive::markSent(const std::size_t index, const Uint64 nowNs) {
+	_lastSentNs[index] = nowNs;
+}
+
+// Existing entries keep their timestamps, so adding a parameter doesn't make
+// every other one look stale at once.
+void KeepAlive::resize(const std::size_t size) {
+	_lastSentNs.resize(size, 0);
+	if (_cursor >= size) {
+		_cursor = 0;
+	}
+	if (size == 0) {
+		_credit = 0.0;
+	}
+}
+
+}  // namespace vts
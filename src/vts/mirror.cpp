@@ -0,0 +1,184 @@
+#include "vts/mirror.hpp"
+
+#include <algorithm>
+#include <cstddef>
+#include <deque>
+#include <span>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include <SDL3/SDL_events.h>
+#include <SDL3/SDL_log.h>
+#include <SDL3/SDL_stdinc.h>
+
+#include "core/settings.hpp"
+#include "vts/model_cache.hpp"
+#include "vts/request.hpp"
+#include "vts/request_tracker.hpp"
+#include "vts/response.hpp"
+#include "vts/session.hpp"
+#include "ws/controller.hpp"
+
+namespace vts {
+
+static constexpr Uint64 MIN_RETRY_DELAY_NS = SDL_MS_TO_NS(1000);
+static constexpr Uint64 MAX_RETRY_DELAY_NS = SDL_MS_TO_NS(30000);
+
+Mirror::Mirror(const std::size_t instance) :
+    _client(instance),
+    _session(),
+    _available(),
+    _isModelLoaded(false),
+    _retryDelayNs(MIN_RETRY_DELAY_NS),
+    _nextRetryNs(0) {
+	_client.start();
+}
+
+Mirror::~Mirror() {
+	_client.stop();
+}
+
+ws::Client& Mirror::getClient() {
+	return _client;
+}
+
+bool Mirror::covers(const std::span<const ParameterValue> values) const {
+	return std::ranges::all_of(values, [this](const ParameterValue& value) {
+		return std::ranges::binary_search(_available, value.id);
+	});
+}
+
+void Mirror::filter(const std::span<const ParameterValue> values,
+                    std::vector<ParameterValue>&          available) const {
+	available.clear();
+	for (const auto& value : values) {
+		if (std::ranges::binary_search(_available, value.id)) {
+			available.push_back(value);
+		}
+	}
+}
+
+// The socket thread stops the client on any error or close. Once it has shut
+// down, a retry is scheduled; the delay doubles on every failure until a
+// session authenticates again.
+void Mirror::checkReconnect(const Uint64 nowNs) {
+	if (_client.getStatus() != ws::Status::DISCONNECTED) {
+		return;
+	}
+	if (_nextRetryNs == 0) {
+		_nextRetryNs  = nowNs + _retryDelayNs;
+		_retryDelayNs = std::min(_retryDelayNs * 2, MAX_RETRY_DELAY_NS);
+		return;
+	}
+	if (nowNs < _nextRetryNs) {
+		return;
+	}
+	SDL_Log("Reconnecting to %s", _client.getUrl());
+	_nextRetryNs   = 0;
+	_isModelLoaded = false;
+	_available.clear();
+	_client.start();
+}
+
+bool Mirror::isReady() {
+	return _isModelLoaded
+	    && !_available.empty()
+	    && _client.getStatus() == ws::Status::AUTHENTICATED;
+}
+
+void Mirror::expire() {
+	_session.expire();
+}
+
+void Mirror::handleParameterList(const SDL_UserEvent& event) {
+	const auto* list = static_cast<ParameterList*>(event.data1);
+	_isModelLoaded   = list->modelLoaded;
+	_available       = getNames(list->parameters);
+	std::ranges::sort(_available);
+}
+
+void Mirror::handleMessage(SDL_UserEvent& event) {
+	if (_session.deliver(event)) {
+		return;
+	}
+	switch (event.code) {
+		case ResponseCode::API_ERROR:
+			_client.stop();
+			break;
+		case ResponseCode::INPUT_PARAMETER_LIST:
+			handleParameterList(event);
+			break;
+		case ResponseCode::MODEL_LOADED:
+			_isModelLoaded = static_cast<ModelStatus*>(event.data1)->modelLoaded;
+			if (_isModelLoaded) {
+				getParameters(_client);
+			}
+			break;
+		case ResponseCode::MODEL_CONFIG_CHANGED:
+			getParameters(_client);
+			break;
+	}
+	releaseResponse(event);
+}
+
+void Mirror::handleOpen() {
+	_session.cancel();
+	REQUESTS.clearInFlight(_client.getInstance());
+	_available.clear();
+	startSession();
+}
+
+// The same handshake as the primary connection's, with this instance's own
+// token; there is no cache to warm-start from and no settings to load.
+Task Mirror::startSession() {
+	const std::size_t instance = _client.getInstance();
+	if (SETTINGS.getAuthToken(instance).empty()) {
+		SDL_UserEvent response = co_await _session.expect(requestToken(_client));
+		if (response.code != ResponseCode::AUTHENTICATION_TOKEN) {
+			_client.stop();
+			co_return;
+		}
+		auto* token = static_cast<std::string*>(response.data1);
+		SETTINGS.setAuthToken(instance, token->c_str());
+		releaseResponse(response);
+	}
+
+	auto authentication = _session.expect(authenticate(_client));
+	auto parameterList  = _session.expect(getParameters(_client));
+
+	const SDL_UserEvent authResponse = co_await authentication;
+	if (authResponse.code == ResponseCode::AUTHENTICATION_FAILURE) {
+		SETTINGS.setAuthToken(instance, "");
+		_client.stop();
+		co_return;
+	}
+	if (authResponse.code != ResponseCode::AUTHENTICATION_SUCCESS) {
+		_client.stop();
+		co_return;
+	}
+	_client.setStatus(ws::Status::AUTHENTICATED);
+	_retryDelayNs = MIN_RETRY_DELAY_NS;
+
+	// Awaited so a refusal from an older VTS build isn't taken as an API error
+	// that drops the connection; the mirror just misses pushed updates.
+	std::deque<PendingResponse> subscriptions;
+	subscriptions.emplace_back(_session,
+	                           subscribeEvent(_client, "ModelLoadedEvent"));
+	subscriptions.emplace_back(
+	    _session,
+	    subscribeEvent(_client, "ModelConfigChangedEvent"));
+
+	SDL_UserEvent listResponse = co_await parameterList;
+	if (listResponse.code == ResponseCode::INPUT_PARAMETER_LIST) {
+		handleParameterList(listResponse);
+	}
+	releaseResponse(listResponse);
+
+	for (auto& subscription : subscriptions) {
+		SDL_UserEvent response = co_await subscription;
+		releaseResponse(response);
+	}
+}
+
+}  // namespace vts
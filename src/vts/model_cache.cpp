@@ -0,0 +1,142 @@
+#include "vts/model_cache.hpp"
+
+#include <fstream>
+#include <iterator>
+#include <map>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include <SDL3/SDL_log.h>
+#include <glaze/core/common.hpp>
+#include <glaze/core/meta.hpp>
+#include <glaze/core/opts.hpp>
+#include <glaze/core/write.hpp>
+#include <glaze/json/read.hpp>
+#include <glaze/json/write.hpp>  // NOLINT(misc-include-cleaner)
+
+namespace vts {
+
+struct ModelCacheFile {
+	std::string                        active;
+	std::map<std::string, CachedModel> models;
+};
+
+}  // namespace vts
+
+template <>
+struct glz::meta<vts::ParameterInfo> {
+	using T                     = vts::ParameterInfo;
+	static constexpr auto value = object("name",
+	                                     &T::name,
+	                                     "min",
+	                                     &T::min,
+	                                     "max",
+	                                     &T::max,
+	                                     "default_value",
+	                                     &T::defaultValue);
+};
+
+template <>
+struct glz::meta<vts::CachedModel> {
+	using T = vts::CachedModel;
+	static constexpr auto value =
+	    object("name", &T::name, "parameters", &T::parameters);
+};
+
+template <>
+struct glz::meta<vts::ModelCacheFile> {
+	using T = vts::ModelCacheFile;
+	static constexpr auto value =
+	    object("active", &T::active, "models", &T::models);
+};
+
+static constexpr auto FILE_PATH = "models.json";
+
+namespace vts {
+
+void ModelCache::load() {
+	std::ifstream file(FILE_PATH);
+	if (!file.is_open()) {
+		return;
+	}
+
+	std::string contents((std::istreambuf_iterator<char>(file)),
+	                     std::istreambuf_iterator<char>());
+	file.close();
+
+	ModelCacheFile data;
+	auto           error = glz::read_json(data, contents);
+	if (error) {
+		SDL_LogWarn(SDL_LOG_CATEGORY_APPLICATION, "Failed to read %s", FILE_PATH);
+		return;
+	}
+	_activeId = std::move(data.active);
+	_models   = std::move(data.models);
+}
+
+void ModelCache::save() const {
+	std::ofstream file(FILE_PATH);
+	if (!file.is_open()) {
+		return;
+	}
+
+	const ModelCacheFile data{.active = _activeId, .models = _models};
+	std::string          jsonString;
+	auto error = glz::write<glz::opts{.prettify = true}>(data, jsonString);
+	if (error) {
+		SDL_LogWarn(SDL_LOG_CATEGORY_APPLICATION, "Failed to write %s", FILE_PATH);
+		return;
+	}
+	file << jsonString;
+	file.close();
+}
+
+ModelCache::ModelCache() :
+    _activeId(),
+    _models() {
+	load();
+}
+
+const CachedModel* ModelCache::find(const std::string& modelId) const {
+	const auto it = _models.find(modelId);
+	if (it == _models.end()) {
+		return nullptr;
+	}
+	return &it->second;
+}
+
+const CachedModel* ModelCache::getActive() const {
+	return find(_activeId);
+}
+
+// Only writes the file when something actually changed, which after the
+// first session with a model is the rare case.
+void ModelCache::store(const ParameterList& list) {
+	if (!list.modelLoaded || list.modelId.empty()) {
+		return;
+	}
+	auto&      model   = _models[list.modelId];
+	const bool changed = _activeId != list.modelId
+	                     || model.name != list.modelName
+	                     || model.parameters != list.parameters;
+	if (!changed) {
+		return;
+	}
+	_activeId        = list.modelId;
+	model.name       = list.modelName;
+	model.parameters = list.parameters;
+	save();
+}
+
+std::vector<std::string> getNames(
+    const std::vector<ParameterInfo>& parameters) {
+	std::vector<std::string> names;
+	names.reserve(parameters.size());
+	for (const auto& parameter : parameters) {
+		names.push_back(parameter.name);
+	}
+	return names;
+}
+
+}  // namespace vts
@@ -0,0 +1,50 @@
+#include "vts/name_table.hpp"
+
+#include <algorithm>
+#include <cstddef>
+#include <string_view>
+
+#include <SDL3/SDL_stdinc.h>
+
+#include "core/meta.hpp"
+
+namespace vts {
+
+ParameterName::ParameterName(std::string_view name) :
+    _data(),
+    _length(0) {
+	name    = name.substr(0, core::MAX_PARAMETER_LENGTH);
+	_length = static_cast<Uint8>(name.size());
+	std::ranges::copy(name, _data);
+	_data[_length] = '\0';
+}
+
+std::string_view ParameterName::view() const {
+	return {_data, _length};
+}
+
+NameTable::NameTable() :
+    _names(),
+    _ids() {}
+
+std::size_t NameTable::size() const {
+	return _names.size();
+}
+
+std::string_view NameTable::view(const NameId id) const {
+	return _names[id].view();
+}
+
+NameId NameTable::intern(const std::string_view name) {
+	const ParameterName stored(name);
+	const auto          it = _ids.find(stored.view());
+	if (it != _ids.end()) {
+		return it->second;
+	}
+	const auto id = static_cast<NameId>(_names.size());
+	_names.push_back(stored);
+	_ids.emplace(_names.back().view(), id);
+	return id;
+}
+
+}  // namespace vts
@@ -2,40 +2,111 @@
 
 #include <algorithm>
 #include <cmath>
-#include <ranges>
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <span>
+#include <string_view>
 #include <tuple>
 #include <utility>
 
 #include "impulse/code.hpp"
 #include "impulse/receiver.hpp"
+#include "impulse/symbol.hpp"
+#include "math/expression.hpp"
+#include "math/formula.hpp"
+#include "math/reduce.hpp"
 
 namespace vts {
 
 static constexpr const char* DEFAULT_PARAMETER_NAME = "MK_NewParameter";
 
-float Parameter::calcImpulseSum() {
-	float total = 0;
-	for (const auto& receiver : _impulseReceivers | std::views::values) {
-		total += receiver.getValue();
+static constexpr std::string_view BLEND_SYMBOL = "blend";
+
+static constexpr std::size_t NO_LANE = SIZE_MAX;
+
+static constexpr float DEFAULT_SPRING_DAMPING = 0.5F;
+static constexpr float MAX_SPRING_DAMPING     = 2.0F;
+static constexpr float MAX_SPRING_FREQUENCY   = 20.0F;
+
+float Parameter::calcImpulseSum() const {
+	return math::reduceSum(getBlendInputs());
+}
+
+float Parameter::calcMajorImpulse() const {
+	return math::reduceMajor(getBlendInputs(), _defaultValue);
+}
+
+std::span<const float> Parameter::getBlendInputs() const {
+	return std::span<const float>(_inputs).first(_blendInputCount);
+}
+
+float Parameter::evaluateExpression(const float blend) {
+	_expressionValues[0] = blend;
+	for (std::size_t i = 0; i < _expressionLanes.size(); ++i) {
+		const std::size_t lane   = _expressionLanes[i];
+		_expressionValues[i + 1] = lane == NO_LANE ? 0.0F : _inputs[lane];
 	}
-	return total;
+	return _expression.evaluate(_expressionValues);
 }
 
-float Parameter::calcMajorImpulse() {
-	float majorValue = 0;
-	float majorDelta = 0;
-	for (const auto& receiver : _impulseReceivers | std::views::values) {
-		const float delta = std::abs(receiver.getValue() - _defaultValue);
-		if ((delta > majorDelta)
-		    || (delta == majorDelta && receiver.getValue() > majorValue)) {
-			majorValue = receiver.getValue();
-			majorDelta = delta;
+// Links come first so a link's index is also its lane.
+void Parameter::rebuildInputs() {
+	_inputs.clear();
+	_inputMaxs.clear();
+	_inputMins.clear();
+	for (const auto& link : _links) {
+		const float lower = link.weight * link.min;
+		const float upper = link.weight * link.max;
+		_inputs.push_back(link.weight * link.value);
+		_inputMaxs.push_back(std::max(lower, upper));
+		_inputMins.push_back(std::min(lower, upper));
+	}
+	for (auto& [code, receiver] : _impulseReceivers) {
+		if (isExpressionInput(code)) {
+			continue;
 		}
+		receiver.setLane(_inputs.size());
+		_inputs.push_back(receiver.getValue());
+		_inputMaxs.push_back(receiver.getMax());
+		_inputMins.push_back(receiver.getMin());
+	}
+	_blendInputCount = _inputs.size();
+	for (const auto code : _expressionReceivers) {
+		auto& receiver = _impulseReceivers.at(code);
+		receiver.setLane(_inputs.size());
+		_inputs.push_back(receiver.getValue());
+	}
+	_expressionLanes.clear();
+	for (const auto code : _expressionCodes) {
+		const auto receiver = _impulseReceivers.find(code);
+		_expressionLanes.push_back(receiver == _impulseReceivers.end()
+		                               ? NO_LANE
+		                               : receiver->second.getLane());
 	}
-	return majorValue;
+	_expressionValues.assign(_expressionCodes.size() + 1, 0.0F);
 }
 
-void Parameter::updateOutput() {
+bool Parameter::commitOutput(float value) {
+	value = math::quantize(value, static_cast<float>(_quantization));
+	if (!isSignificant(value)) {
+		return false;
+	}
+	_output = value;
+	return true;
+}
+
+bool Parameter::isSignificant(const float value) const {
+	if (value == _output) {
+		return false;
+	}
+	if ((value == _min) || (value == _max) || (value == _defaultValue)) {
+		return true;
+	}
+	return std::abs(value - _output) > _epsilon;
+}
+
+bool Parameter::updateOutput() {
 	float newOutput = 0;
 	switch (_blendMode) {
 		case BlendMode::MAX:
@@ -46,25 +117,43 @@ void Parameter::updateOutput() {
 			newOutput = std::clamp(newOutput, _min, _max);
 			break;
 	}
-	if (_output == newOutput) {
-		return;
+	if (!_expression.isEmpty()) {
+		newOutput = std::clamp(evaluateExpression(newOutput), _min, _max);
 	}
-	_output = newOutput;
-	_fresh  = true;
+	_target = newOutput;
+	if (hasSpring()) {
+		return false;
+	}
+	return commitOutput(newOutput);
 }
 
 Parameter::Parameter() :
     Parameter(DEFAULT_PARAMETER_NAME) {}
 
 Parameter::Parameter(const std::string& name) :
+    _blendInputCount(0),
     _blendMode(BlendMode::MAX),
-    _fresh(false),
     _defaultValue(0.0F),
+    _epsilon(0.0F),
     _max(1.0F),
     _min(0.0F),
     _output(0.0F),
+    _quantization(0),
+    _springDamping(DEFAULT_SPRING_DAMPING),
+    _springFrequency(0.0F),
+    _target(0.0F),
     _impulseReceivers(),
-    _name(name) {}
+    _links(),
+    _name(name),
+    _inputs(),
+    _inputMaxs(),
+    _inputMins(),
+    _expression(),
+    _expressionSource(),
+    _expressionCodes(),
+    _expressionLanes(),
+    _expressionValues(),
+    _expressionReceivers() {}
 
 BlendMode Parameter::getBlendMode() const {
 	return _blendMode;
@@ -74,18 +163,35 @@ bool Parameter::hasImpulses() const {
 	return !_impulseReceivers.empty();
 }
 
-bool Parameter::isFresh() {
-	if (_fresh) {
-		_fresh = false;
-		return true;
-	}
-	return false;
+bool Parameter::hasSpring() const {
+	return _springFrequency > 0.0F;
+}
+
+bool Parameter::isExpressionInput(const imp::Code code) const {
+	return std::ranges::find(_expressionReceivers, code)
+	       != _expressionReceivers.end();
+}
+
+bool Parameter::isResting() const {
+	return _output == _defaultValue;
 }
 
 const imp::Receiver& Parameter::getReceiver(const imp::Code code) const {
 	return _impulseReceivers.at(code);
 }
 
+const ParameterLinks& Parameter::getLinks() const {
+	return _links;
+}
+
+ParameterLinks& Parameter::getLinks() {
+	return _links;
+}
+
+const std::string& Parameter::getExpression() const {
+	return _expressionSource;
+}
+
 const std::string& Parameter::getName() const {
 	return _name;
 }
@@ -98,6 +204,10 @@ const ImpulseReceiverMap& Parameter::getReceivers() const {
 	return _impulseReceivers;
 };
 
+float Parameter::getEpsilon() const {
+	return _epsilon;
+}
+
 float Parameter::getMax() const {
 	return _max;
 }
@@ -114,29 +224,84 @@ float Parameter::getOutput() const {
 	return _output;
 }
 
+float Parameter::getSpringDamping() const {
+	return _springDamping;
+}
+
+float Parameter::getSpringFrequency() const {
+	return _springFrequency;
+}
+
+float Parameter::getTarget() const {
+	return _target;
+}
+
+int Parameter::getQuantization() const {
+	return _quantization;
+}
+
 void Parameter::addImpulse(const imp::Code code, const bool isInverted) {
-	_impulseReceivers.emplace(std::piecewise_construct,
-	                          std::forward_as_tuple(code),
-	                          std::forward_as_tuple(code, isInverted));
+	const auto [receiver, isAdded] = _impulseReceivers.emplace(
+	    std::piecewise_construct,
+	    std::forward_as_tuple(code),
+	    std::forward_as_tuple(code, isInverted));
+	if (!isAdded && std::erase(_expressionReceivers, code) != 0) {
+		receiver->second.setInverted(isInverted);
+	}
+	updateBounds();
+}
+
+void Parameter::addLink(const std::string& source, const float weight) {
+	const auto link = std::ranges::find(_links, source, &ParameterLink::source);
+	if (link != _links.end()) {
+		link->weight = weight;
+	}
+	else {
+		_links.push_back({.source = source, .weight = weight});
+	}
 	updateBounds();
 }
 
 void Parameter::clearImpulses() {
 	_impulseReceivers.clear();
+	_expressionReceivers.clear();
 	updateBounds();
 }
 
-void Parameter::handleImpulse(const imp::Code code, const float value) {
+bool Parameter::handleImpulse(const imp::Code code, const float value) {
 	auto receiver = _impulseReceivers.find(code);
 	if (receiver == _impulseReceivers.end()) {
-		return;
+		return false;
 	}
 	receiver->second.update(value);
-	updateOutput();
+	_inputs[receiver->second.getLane()] = receiver->second.getValue();
+	return updateOutput();
+}
+
+bool Parameter::handleLink(const std::size_t link, const float value) {
+	auto& entry = _links[link];
+	if (entry.value == value) {
+		return false;
+	}
+	entry.value   = value;
+	_inputs[link] = entry.weight * value;
+	return updateOutput();
+}
+
+bool Parameter::handleSpring(const float position) {
+	return commitOutput(position);
 }
 
 void Parameter::removeImpulse(const imp::Code code) {
 	_impulseReceivers.erase(code);
+	std::erase(_expressionReceivers, code);
+	updateBounds();
+}
+
+void Parameter::removeLink(const std::string& source) {
+	std::erase_if(_links, [&source](const ParameterLink& link) {
+		return link.source == source;
+	});
 	updateBounds();
 }
 
@@ -145,22 +310,116 @@ void Parameter::setBlendMode(const BlendMode mode) {
 	updateBounds();
 }
 
+void Parameter::setEpsilon(const float epsilon) {
+	_epsilon = std::max(epsilon, 0.0F);
+}
+
+// Receivers added for the previous expression are dropped first, so inputs
+// the new one no longer reads stop driving the parameter.
+ExpressionResult Parameter::setExpression(const std::string& source) {
+	for (const auto code : _expressionReceivers) {
+		_impulseReceivers.erase(code);
+	}
+	_expressionReceivers.clear();
+	_expressionSource = source;
+	_expression       = math::Expression();
+	_expressionCodes.clear();
+	if (source.empty()) {
+		updateBounds();
+		return std::nullopt;
+	}
+
+	std::vector<imp::Code> codes;
+	const auto             resolve =
+	    [&codes](const std::string_view name) -> std::optional<std::size_t> {
+		if (name == BLEND_SYMBOL) {
+			return 0;
+		}
+		const auto code = imp::findSymbol(name);
+		if (!code) {
+			return std::nullopt;
+		}
+		const auto it = std::ranges::find(codes, *code);
+		if (it == codes.end()) {
+			codes.push_back(*code);
+			return codes.size();
+		}
+		return static_cast<std::size_t>(it - codes.begin()) + 1;
+	};
+	auto compiled = math::Expression::compile(source, resolve);
+	if (!compiled) {
+		updateBounds();
+		return compiled.error();
+	}
+
+	_expression      = std::move(*compiled);
+	_expressionCodes = std::move(codes);
+	for (const auto code : _expressionCodes) {
+		const auto [receiver, isAdded] = _impulseReceivers.emplace(
+		    std::piecewise_construct,
+		    std::forward_as_tuple(code),
+		    std::forward_as_tuple(code));
+		if (isAdded) {
+			_expressionReceivers.push_back(code);
+		}
+	}
+	updateBounds();
+	return std::nullopt;
+}
+
+// Inverting flips the sign of the receiver's current value, so its lane and
+// the output are refreshed right away rather than on the next impulse.
+bool Parameter::setInverted(const imp::Code code, const bool isInverted) {
+	auto receiver = _impulseReceivers.find(code);
+	if (receiver == _impulseReceivers.end()
+	    || receiver->second.getIsInverted() == isInverted) {
+		return false;
+	}
+	receiver->second.setInverted(isInverted);
+	updateBounds();
+	return updateOutput();
+}
+
+bool Parameter::setLinkRange(const std::size_t link,
+                             const float       min,
+                             const float       max) {
+	auto& entry = _links[link];
+	if ((entry.min == min) && (entry.max == max)) {
+		return false;
+	}
+	entry.min = min;
+	entry.max = max;
+	updateBounds();
+	return true;
+}
+
 void Parameter::setName(const std::string& name) {
 	_name = name;
 }
 
+void Parameter::setQuantization(const int steps) {
+	_quantization = std::max(steps, 0);
+}
+
+void Parameter::setSpring(const float frequency, const float damping) {
+	_springFrequency = std::clamp(frequency, 0.0F, MAX_SPRING_FREQUENCY);
+	_springDamping   = std::clamp(damping, 0.0F, MAX_SPRING_DAMPING);
+	if (!hasSpring()) {
+		commitOutput(_target);
+	}
+}
+
+// Receivers only the expression reads don't widen the range, and the
+// expression's result is clamped to it.
 void Parameter::updateBounds() {
-	if (_impulseReceivers.empty()) {
+	rebuildInputs();
+	if (_blendInputCount == 0) {
 		_max = 1.0F;
 		_min = 0.0F;
 		return;
 	}
-	_max = _defaultValue;
-	_min = _defaultValue;
-	for (const auto& receiver : _impulseReceivers | std::views::values) {
-		_max = std::max(_max, receiver.getMax());
-		_min = std::min(_min, receiver.getMin());
-	}
+	_max = math::reduceMax(_inputMaxs, _defaultValue);
+	_min = math::reduceMin(_inputMins, _defaultValue);
 }
 
 }  // namespace vts
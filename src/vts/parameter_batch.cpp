@@ -0,0 +1,54 @@
+#include "vts/parameter_batch.hpp"
+
+#include <string>
+#include <vector>
+
+#include <SDL3/SDL_stdinc.h>
+
+#include "core/settings.hpp"
+#include "vts/parameter.hpp"
+#include "vts/request.hpp"
+#include "ws/controller.hpp"
+
+namespace vts {
+
+ParameterBatch::ParameterBatch() :
+    _creations(),
+    _deletions() {}
+
+const std::vector<Parameter>& ParameterBatch::getCreations() const {
+	return _creations;
+}
+
+const std::vector<std::string>& ParameterBatch::getDeletions() const {
+	return _deletions;
+}
+
+bool ParameterBatch::isEmpty() const {
+	return _creations.empty() && _deletions.empty();
+}
+
+void ParameterBatch::create(const Parameter& parameter) {
+	_creations.push_back(parameter);
+}
+
+void ParameterBatch::remove(const std::string& name) {
+	_deletions.push_back(name);
+}
+
+std::vector<Uint64> ParameterBatch::send(ws::IController& wsController) const {
+	SETTINGS.removeParameters(_deletions);
+	SETTINGS.setParameters(_creations);
+
+	std::vector<Uint64> ids;
+	ids.reserve(_creations.size() + _deletions.size());
+	for (const auto& name : _deletions) {
+		ids.push_back(deleteParameter(wsController, name));
+	}
+	for (const auto& parameter : _creations) {
+		ids.push_back(createParameter(wsController, parameter));
+	}
+	return ids;
+}
+
+}  // namespace vts
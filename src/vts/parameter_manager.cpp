@@ -1,49 +1,421 @@
 #include "vts/parameter_manager.hpp"
 
-#include <ranges>
+#include <algorithm>
+#include <cstddef>
+#include <span>
 #include <string>
+#include <string_view>
+#include <unordered_set>
+#include <utility>
+#include <vector>
+
+#include <SDL3/SDL_log.h>
 
 #include "impulse/code.hpp"
+#include "vts/spring.hpp"
 
 namespace vts {
 
+static constexpr std::size_t UNVISITED = SIZE_MAX;
+
+// Labels each parameter with its strongly connected component (Tarjan's
+// algorithm, iterative). Two parameters share a label exactly when they sit
+// on a common cycle.
+static std::vector<std::size_t> findComponents(const ParameterEdges& edges) {
+	const std::size_t nNodes = edges.size();
+
+	std::vector<std::size_t> component(nNodes, UNVISITED);
+	std::vector<std::size_t> visitIndex(nNodes, UNVISITED);
+	std::vector<std::size_t> lowLink(nNodes, 0);
+	std::vector<bool>        isOnStack(nNodes, false);
+	std::vector<std::size_t> stack;
+	std::size_t              nextIndex     = 0;
+	std::size_t              nextComponent = 0;
+
+	// Each frame is a node and the next of its edges to explore.
+	std::vector<std::pair<std::size_t, std::size_t>> frames;
+
+	for (std::size_t root = 0; root < nNodes; ++root) {
+		if (visitIndex[root] != UNVISITED) {
+			continue;
+		}
+		frames.emplace_back(root, 0);
+		while (!frames.empty()) {
+			auto& [node, edge] = frames.back();
+			if (edge == 0) {
+				visitIndex[node] = lowLink[node] = nextIndex++;
+				stack.push_back(node);
+				isOnStack[node] = true;
+			}
+			if (edge < edges[node].size()) {
+				const std::size_t next = edges[node][edge++].target;
+				if (visitIndex[next] == UNVISITED) {
+					frames.emplace_back(next, 0);
+				}
+				else if (isOnStack[next]) {
+					lowLink[node] = std::min(lowLink[node], visitIndex[next]);
+				}
+				continue;
+			}
+			const std::size_t done = node;
+			frames.pop_back();
+			if (!frames.empty()) {
+				const std::size_t parent = frames.back().first;
+				lowLink[parent] = std::min(lowLink[parent], lowLink[done]);
+			}
+			if (lowLink[done] != visitIndex[done]) {
+				continue;
+			}
+			std::size_t member = UNVISITED;
+			while (member != done) {
+				member = stack.back();
+				stack.pop_back();
+				isOnStack[member] = false;
+				component[member] = nextComponent;
+			}
+			++nextComponent;
+		}
+	}
+	return component;
+}
+
+void ParameterManager::markChanged(const std::size_t index) {
+	_dirty.set(index);
+	_pending.set(_ranks[index]);
+}
+
+// Compacts the surviving parameters in place. Indices shift, so per-index
+// bookkeeping is rebuilt and every survivor is queued for resending.
+// Springs are re-seeded from the current outputs.
+void ParameterManager::removeMissing(const std::span<const std::string> names) {
+	const std::unordered_set<std::string_view> incoming(names.begin(),
+	                                                    names.end());
+
+	std::size_t kept = 0;
+	for (std::size_t i = 0; i < _parameters.size(); ++i) {
+		if (!incoming.contains(_parameters[i].getName())) {
+			continue;
+		}
+		if (kept != i) {
+			_parameters[kept] = std::move(_parameters[i]);
+			_nameIds[kept]    = _nameIds[i];
+		}
+		++kept;
+	}
+	if (kept == _parameters.size()) {
+		return;
+	}
+
+	_parameters.erase(_parameters.begin() + kept, _parameters.end());
+	_nameIds.resize(kept);
+	_indices.clear();
+	for (std::size_t i = 0; i < kept; ++i) {
+		_indices.emplace(_parameters[i].getName(), i);
+	}
+	_dirty.resize(0);
+	_dirty.resize(kept);
+	markAllChanged();
+	_keepAlive.resize(0);
+	_keepAlive.resize(kept);
+	rebuildGraph();
+	rebuildSprings();
+}
+
+void ParameterManager::seedLinks() {
+	for (const std::size_t source : _order) {
+		const auto& parameter = _parameters[source];
+		for (const auto& [target, link] : _dependents[source]) {
+			_parameters[target].setLinkRange(link,
+			                                 parameter.getMin(),
+			                                 parameter.getMax());
+			if (_parameters[target].handleLink(link, parameter.getOutput())) {
+				_dirty.set(target);
+			}
+		}
+	}
+}
+
+void ParameterManager::updateSampleLinks() {
+	const auto& links = _sample.getLinks();
+	for (std::size_t i = 0; i < links.size(); ++i) {
+		const auto* source = find(links[i].source);
+		if (source == nullptr) {
+			continue;
+		}
+		_sample.setLinkRange(i, source->getMin(), source->getMax());
+		_sample.handleLink(i, source->getOutput());
+	}
+}
+
 ParameterManager::ParameterManager() :
     _sample(),
-    _parameters() {}
+    _parameters(),
+    _indices(),
+    _names(),
+    _nameIds(),
+    _dirty(),
+    _keepAlive(),
+    _dependents(),
+    _order(),
+    _ranks(),
+    _pending(),
+    _springs(),
+    _sampleSpring() {}
 
-bool ParameterManager::isEmpty() const {
-	return _parameters.empty();
+bool ParameterManager::createsCycle(const std::string&    target,
+                                    const ParameterLinks& links) const {
+	for (const auto& link : links) {
+		if (link.source == target) {
+			return true;
+		}
+	}
+	const auto root = _indices.find(target);
+	if (root == _indices.end()) {
+		return false;
+	}
+
+	std::vector<bool>        reachable(_parameters.size(), false);
+	std::vector<std::size_t> stack{root->second};
+	while (!stack.empty()) {
+		const std::size_t node = stack.back();
+		stack.pop_back();
+		if (reachable[node]) {
+			continue;
+		}
+		reachable[node] = true;
+		for (const auto& edge : _dependents[node]) {
+			stack.push_back(edge.target);
+		}
+	}
+
+	for (const auto& link : links) {
+		const auto source = _indices.find(link.source);
+		if (source != _indices.end() && reachable[source->second]) {
+			return true;
+		}
+	}
+	return false;
 }
 
-ParameterStore::iterator ParameterManager::end() {
-	return _parameters.end();
+bool ParameterManager::isEmpty() const {
+	return _parameters.empty();
 }
 
-ParameterStore::iterator ParameterManager::find(const std::string& name) {
-	return _parameters.find(name);
+Parameter* ParameterManager::find(const std::string& name) {
+	auto it = _indices.find(name);
+	if (it == _indices.end()) {
+		return nullptr;
+	}
+	return &_parameters[it->second];
 }
 
 Parameter& ParameterManager::getSample() {
 	return _sample;
 }
 
-auto ParameterManager::values() -> ParameterView {
-	return _parameters | std::views::values;
+// Replaces a parameter with a fresh one of the same name, dropping its
+// receivers, links and expression so its settings can be applied anew.
+Parameter* ParameterManager::reset(const std::string& name) {
+	const auto it = _indices.find(name);
+	if (it == _indices.end()) {
+		return nullptr;
+	}
+	_parameters[it->second] = Parameter(name);
+	_dirty.set(it->second);
+	return &_parameters[it->second];
+}
+
+ParameterView ParameterManager::values() {
+	return _parameters;
 }
 
 void ParameterManager::add(const std::string& name) {
-	_parameters.emplace(name, name);
+	if (_indices.contains(name)) {
+		return;
+	}
+	const std::size_t index = _parameters.size();
+	_indices.emplace(name, index);
+	_parameters.emplace_back(name);
+	_nameIds.push_back(_names.intern(name));
+	_dependents.emplace_back();
+	_ranks.push_back(_order.size());
+	_order.push_back(index);
+	_dirty.resize(_parameters.size());
+	_pending.resize(_parameters.size());
+	_keepAlive.resize(_parameters.size());
 }
 
 void ParameterManager::clear() {
 	_parameters.clear();
+	_indices.clear();
+	_nameIds.clear();
+	_dependents.clear();
+	_order.clear();
+	_ranks.clear();
+	_dirty.resize(0);
+	_pending.resize(0);
+	_keepAlive.resize(0);
+	_springs.clear();
 }
 
 void ParameterManager::distributeImpulse(imp::Code code, float value) {
-	for (auto& parameter : values()) {
-		parameter.handleImpulse(code, value);
+	for (std::size_t i = 0; i < _parameters.size(); ++i) {
+		if (_parameters[i].handleImpulse(code, value)) {
+			markChanged(i);
+		}
 	}
 	_sample.handleImpulse(code, value);
 }
 
+// Queues every parameter for sending without touching link propagation,
+// which only needs to rerun for values that actually moved.
+void ParameterManager::markAllChanged() {
+	for (std::size_t i = 0; i < _parameters.size(); ++i) {
+		_dirty.set(i);
+	}
+}
+
+// Sources also pass on their current range: a target whose bounds change is
+// queued as well, so the new range reaches everything further downstream.
+void ParameterManager::propagate() {
+	_pending.drain([this](const std::size_t rank) {
+		const std::size_t source    = _order[rank];
+		const auto&       parameter = _parameters[source];
+		for (const auto& [target, link] : _dependents[source]) {
+			auto& dependent = _parameters[target];
+			if (dependent.setLinkRange(link, parameter.getMin(), parameter.getMax())) {
+				_pending.set(_ranks[target]);
+			}
+			if (dependent.handleLink(link, parameter.getOutput())) {
+				markChanged(target);
+			}
+		}
+	});
+	updateSampleLinks();
+}
+
+void ParameterManager::rebuildGraph() {
+	const std::size_t nParameters = _parameters.size();
+
+	_dependents.assign(nParameters, {});
+	for (std::size_t target = 0; target < nParameters; ++target) {
+		const auto& links = _parameters[target].getLinks();
+		for (std::size_t link = 0; link < links.size(); ++link) {
+			const auto source = _indices.find(links[link].source);
+			if (source != _indices.end()) {
+				_dependents[source->second].push_back({target, link});
+			}
+		}
+	}
+
+	// Only links between members of the same cycle are cut; parameters that
+	// merely depend on a cycle keep theirs.
+	const auto  component = findComponents(_dependents);
+	std::size_t nCut      = 0;
+	for (std::size_t source = 0; source < nParameters; ++source) {
+		nCut += std::erase_if(_dependents[source],
+		                      [&](const ParameterEdge& edge) {
+			                      return component[edge.target]
+			                             == component[source];
+		                      });
+	}
+	if (nCut != 0) {
+		SDL_LogWarn(SDL_LOG_CATEGORY_APPLICATION,
+		            "Ignoring %zu link(s) caught in a cycle",
+		            nCut);
+	}
+
+	std::vector<std::size_t> inDegree(nParameters, 0);
+	for (const auto& edges : _dependents) {
+		for (const auto& edge : edges) {
+			++inDegree[edge.target];
+		}
+	}
+
+	_order.clear();
+	for (std::size_t i = 0; i < nParameters; ++i) {
+		if (inDegree[i] == 0) {
+			_order.push_back(i);
+		}
+	}
+	for (std::size_t head = 0; head < _order.size(); ++head) {
+		for (const auto& edge : _dependents[_order[head]]) {
+			if (--inDegree[edge.target] == 0) {
+				_order.push_back(edge.target);
+			}
+		}
+	}
+
+	_ranks.assign(nParameters, 0);
+	for (std::size_t rank = 0; rank < nParameters; ++rank) {
+		_ranks[_order[rank]] = rank;
+	}
+	_pending.resize(nParameters);
+	_pending.clear();
+	seedLinks();
+}
+
+void ParameterManager::rebuildSprings() {
+	_springs.clear();
+	for (std::size_t i = 0; i < _parameters.size(); ++i) {
+		const auto& parameter = _parameters[i];
+		if (parameter.hasSpring()) {
+			_springs.add(i,
+			             parameter.getSpringFrequency(),
+			             parameter.getSpringDamping(),
+			             parameter.getOutput());
+		}
+	}
+}
+
+// Applies a fresh list from VTS as a diff: parameters that are still present
+// keep their receivers and outputs, missing ones are dropped and new ones are
+// appended. Returns the names that were added; callers apply their settings
+// and then rebuild the graph and springs.
+std::vector<std::string> ParameterManager::sync(
+    const std::span<const std::string> names) {
+	removeMissing(names);
+
+	std::vector<std::string> added;
+	for (const auto& name : names) {
+		if (!_indices.contains(name)) {
+			add(name);
+			added.push_back(name);
+		}
+	}
+	return added;
+}
+
+void ParameterManager::simulate(const Uint64 nowNs) {
+	const auto owners  = _springs.owners();
+	const auto targets = _springs.targets();
+	for (std::size_t i = 0; i < owners.size(); ++i) {
+		targets[i] = _parameters[owners[i]].getTarget();
+	}
+
+	const std::size_t steps = _springs.step(nowNs);
+	if (steps == 0) {
+		return;
+	}
+
+	const auto positions = _springs.positions();
+	for (std::size_t i = 0; i < owners.size(); ++i) {
+		if (_parameters[owners[i]].handleSpring(positions[i])) {
+			markChanged(owners[i]);
+		}
+	}
+
+	if (_sample.hasSpring()) {
+		SpringBank::integrateSingle(_sampleSpring,
+		                            _sample.getSpringFrequency(),
+		                            _sample.getSpringDamping(),
+		                            _sample.getTarget(),
+		                            steps);
+		_sample.handleSpring(_sampleSpring.position);
+	}
+	else {
+		_sampleSpring = {.position = _sample.getOutput(), .velocity = 0.0F};
+	}
+}
+
 }  // namespace vts
@@ -0,0 +1,45 @@
+#include "vts/refresh_debouncer.hpp"
+
+#include <SDL3/SDL_stdinc.h>
+
+#include "vts/request_tracker.hpp"
+
+namespace vts {
+
+static constexpr Uint64 DEBOUNCE_NS = 100'000'000;
+
+RefreshDebouncer::RefreshDebouncer() :
+    _delayNs(DEBOUNCE_NS),
+    _dueNs(0),
+    _requestId(0),
+    _isScheduled(false) {}
+
+// The tracker forgets an id once its response arrives or it times out.
+bool RefreshDebouncer::isInFlight() const {
+	return _requestId != 0 && REQUESTS.isInFlight(_requestId);
+}
+
+// Skips the debounce window, for callers that know nothing else is coming.
+void RefreshDebouncer::flush(const Uint64 nowNs) {
+	_dueNs       = nowNs;
+	_isScheduled = true;
+}
+
+bool RefreshDebouncer::poll(const Uint64 nowNs) {
+	if (!_isScheduled || nowNs < _dueNs || isInFlight()) {
+		return false;
+	}
+	_isScheduled = false;
+	return true;
+}
+
+void RefreshDebouncer::schedule(const Uint64 nowNs) {
+	_dueNs       = nowNs + _delayNs;
+	_isScheduled = true;
+}
+
+void RefreshDebouncer::setRequest(const Uint64 requestId) {
+	_requestId = requestId;
+}
+
+}  // namespace vts
@@ -2,12 +2,21 @@
 
 #include <iostream>
 
+#include <algorithm>
+#include <charconv>
+#include <cmath>
+#include <cstddef>
+#include <memory>
 #include <optional>
+#include <span>
 #include <string>
 #include <string_view>
+#include <system_error>
 #include <utility>
 #include <vector>
 
+#include <SDL3/SDL_stdinc.h>
+#include <SDL3/SDL_timer.h>
 #include <glaze/core/common.hpp>
 #include <glaze/core/context.hpp>
 #include <glaze/core/reflect.hpp>
@@ -16,6 +25,7 @@
 #include "core/meta.hpp"
 #include "core/settings.hpp"
 #include "vts/parameter.hpp"
+#include "vts/request_tracker.hpp"
 #include "ws/controller.hpp"
 
 static void logError(const glz::error_ctx& error, const std::string& buffer) {
@@ -38,11 +48,13 @@ static std::optional<std::string> stringify(const T& value) {
 
 namespace vts {
 
+// Ids are the decimal form of the tracker's counter; VTS echoes them back as
+// requestID, which is how responses find their request.
 struct BaseRequest {
-	std::string apiName    = "VTubeStudioPublicAPI";
-	std::string apiVersion = "1.0";
-	std::string requestId  = "SomeID";
-	std::string messageType;
+	std::string_view apiName    = "VTubeStudioPublicAPI";
+	std::string_view apiVersion = "1.0";
+	std::string      requestId  = {};
+	std::string_view messageType;
 
 	struct glaze {
 		using T                     = BaseRequest;
@@ -50,7 +62,7 @@ struct BaseRequest {
 		                                          &T::apiName,
 		                                          "apiVersion",
 		                                          &T::apiVersion,
-		                                          "requestId",
+		                                          "requestID",
 		                                          &T::requestId,
 		                                          "messageType",
 		                                          &T::messageType);
@@ -61,8 +73,8 @@ template <typename DataType>
 struct Request : BaseRequest {
 	DataType data;
 
-	Request(const std::string& messageTypeRef, DataType&& requestData) :
-	    BaseRequest{.messageType{messageTypeRef}},
+	Request(const RequestType type, DataType&& requestData) :
+	    BaseRequest{.messageType{getMessageType(type)}},
 	    data(std::move(requestData)) {}
 
 	struct glaze {
@@ -71,7 +83,7 @@ struct Request : BaseRequest {
 		                                          &T::apiName,
 		                                          "apiVersion",
 		                                          &T::apiVersion,
-		                                          "requestId",
+		                                          "requestID",
 		                                          &T::requestId,
 		                                          "messageType",
 		                                          &T::messageType,
@@ -80,6 +92,36 @@ struct Request : BaseRequest {
 	};
 };
 
+// Requests the user is waiting on go ahead of large, rarely sent ones.
+static constexpr ws::Lane getLane(const RequestType type) {
+	switch (type) {
+		case RequestType::AUTHENTICATION_TOKEN:
+		case RequestType::PARAMETER_CREATION:
+		case RequestType::PARAMETER_DELETION:
+			return ws::Lane::BULK;
+		default:
+			return ws::Lane::CONTROL;
+	}
+}
+
+template <typename T>
+static Uint64 send(ws::IController&  wsController,
+                   const RequestType type,
+                   T&                request) {
+	const Uint64 id   = REQUESTS.begin(type,
+	                                   wsController.getInstance(),
+	                                   SDL_GetTicksNS());
+	request.requestId = std::to_string(id);
+
+	auto message = stringify(request);
+	if (!message) {
+		REQUESTS.cancel(id);
+		return 0;
+	}
+	wsController.sendMessage(std::move(*message), getLane(type));
+	return id;
+}
+
 struct AuthenticationData {
 	std::string pluginName      = core::PLUGIN_NAME;
 	std::string pluginDeveloper = core::PLUGIN_DEVELOPER;
@@ -96,19 +138,15 @@ struct AuthenticationData {
 	};
 };
 
-void authenticate(ws::IController& wsController) {
-	std::string token = SETTINGS.getAuthToken();
+Uint64 authenticate(ws::IController& wsController) {
+	std::string token = SETTINGS.getAuthToken(wsController.getInstance());
 	if (!token.empty()) {
-		const Request<AuthenticationData> request(
-		    "AuthenticationRequest",
+		Request<AuthenticationData> request(
+		    RequestType::AUTHENTICATION,
 		    AuthenticationData{.authenticationToken = std::move(token)});
-		if (auto message = stringify(request)) {
-			wsController.sendMessage(std::move(*message));
-		}
-	}
-	else {
-		requestToken(wsController);
+		return send(wsController, RequestType::AUTHENTICATION, request);
 	}
+	return requestToken(wsController);
 }
 
 struct AuthenticationTokenRequestData {
@@ -127,13 +165,11 @@ struct AuthenticationTokenRequestData {
 	};
 };
 
-void requestToken(ws::IController& wsController) {
-	const Request<AuthenticationTokenRequestData> request(
-	    "AuthenticationTokenRequest",
+Uint64 requestToken(ws::IController& wsController) {
+	Request<AuthenticationTokenRequestData> request(
+	    RequestType::AUTHENTICATION_TOKEN,
 	    AuthenticationTokenRequestData());
-	if (auto message = stringify(request)) {
-		wsController.sendMessage(std::move(*message));
-	}
+	return send(wsController, RequestType::AUTHENTICATION_TOKEN, request);
 }
 
 struct ParameterCreationRequestData {
@@ -158,18 +194,16 @@ struct ParameterCreationRequestData {
 	};
 };
 
-void createParameter(ws::IController& wsController,
-                     const Parameter& parameter) {
-	const Request<ParameterCreationRequestData> request(
-	    "ParameterCreationRequest",
+Uint64 createParameter(ws::IController& wsController,
+                       const Parameter& parameter) {
+	Request<ParameterCreationRequestData> request(
+	    RequestType::PARAMETER_CREATION,
 	    ParameterCreationRequestData{
 	        .parameterName = parameter.getName(),
 	        .min           = parameter.getMin(),
 	        .max           = parameter.getMax(),
 	    });
-	if (auto message = stringify(request)) {
-		wsController.sendMessage(std::move(*message));
-	}
+	return send(wsController, RequestType::PARAMETER_CREATION, request);
 }
 
 struct ParameterDeletionData {
@@ -181,27 +215,102 @@ struct ParameterDeletionData {
 	};
 };
 
-void deleteParameter(ws::IController&       wsController,
-                     const std::string_view name) {
-	const Request<ParameterDeletionData> request(
-	    "ParameterDeletionRequest",
+Uint64 deleteParameter(ws::IController&       wsController,
+                       const std::string_view name) {
+	Request<ParameterDeletionData> request(
+	    RequestType::PARAMETER_DELETION,
 	    ParameterDeletionData{.parameterName = std::string{name}});
-	if (auto message = stringify(request)) {
-		wsController.sendMessage(std::move(*message));
-	}
+	return send(wsController, RequestType::PARAMETER_DELETION, request);
+}
+
+Uint64 getParameters(ws::IController& wsController) {
+	BaseRequest request{
+	    .messageType = getMessageType(RequestType::INPUT_PARAMETER_LIST)};
+	return send(wsController, RequestType::INPUT_PARAMETER_LIST, request);
 }
 
-void getParameters(ws::IController& wsController) {
-	const BaseRequest request{.messageType = "InputParameterListRequest"};
-	if (auto message = stringify(request)) {
-		wsController.sendMessage(std::move(*message));
+struct ItemListRequestData {
+	bool includeAvailableSpots       = false;
+	bool includeItemInstancesInScene = true;
+	bool includeAvailableItemFiles   = false;
+
+	struct glaze {
+		using T                     = ItemListRequestData;
+		static constexpr auto value = glz::object("includeAvailableSpots",
+		                                          &T::includeAvailableSpots,
+		                                          "includeItemInstancesInScene",
+		                                          &T::includeItemInstancesInScene,
+		                                          "includeAvailableItemFiles",
+		                                          &T::includeAvailableItemFiles);
+	};
+};
+
+Uint64 getItems(ws::IController& wsController) {
+	Request<ItemListRequestData> request(RequestType::ITEM_LIST,
+	                                     ItemListRequestData());
+	return send(wsController, RequestType::ITEM_LIST, request);
+}
+
+struct EventSubscriptionData {
+	std::string_view eventName;
+	bool             subscribe = true;
+
+	struct glaze {
+		using T                     = EventSubscriptionData;
+		static constexpr auto value = glz::object("eventName",
+		                                          &T::eventName,
+		                                          "subscribe",
+		                                          &T::subscribe);
+	};
+};
+
+Uint64 subscribeEvent(ws::IController&       wsController,
+                      const std::string_view eventName) {
+	Request<EventSubscriptionData> request(
+	    RequestType::EVENT_SUBSCRIPTION,
+	    EventSubscriptionData{.eventName = eventName});
+	return send(wsController, RequestType::EVENT_SUBSCRIPTION, request);
+}
+
+struct ItemMoveRequestData {
+	std::span<const ItemMove> itemsToMove;
+
+	struct glaze {
+		using T                     = ItemMoveRequestData;
+		static constexpr auto value = glz::object("itemsToMove", &T::itemsToMove);
+	};
+};
+
+// Sent whenever an item changes, so the message reuses a spare buffer
+// instead of allocating one like the other requests.
+Uint64 moveItems(ws::IController&                wsController,
+                 const std::span<const ItemMove> moves) {
+	if (wsController.getStatus() != ws::Status::AUTHENTICATED) {
+		return 0;
+	}
+	Request<ItemMoveRequestData> request(
+	    RequestType::ITEM_MOVE,
+	    ItemMoveRequestData{.itemsToMove = moves});
+	const Uint64 id   = REQUESTS.begin(RequestType::ITEM_MOVE,
+	                                   wsController.getInstance(),
+	                                   SDL_GetTicksNS());
+	request.requestId = std::to_string(id);
+
+	std::string message = wsController.acquireBuffer();
+	auto        error   = glz::write_json(request, message);
+	if (error) {
+		logError(error, message);
+		REQUESTS.cancel(id);
+		return 0;
 	}
+	wsController.sendMessage(std::move(message), ws::Lane::CONTROL);
+	return id;
 }
 
 struct InjectParameterDataRequestData {
-	bool                        faceFound = false;
-	std::string                 mode      = "set";
-	std::vector<ParameterValue> parameterValues;
+	bool                            faceFound = false;
+	std::string_view                mode      = "set";
+	std::span<const ParameterValue> parameterValues;
 
 	struct glaze {
 		using T                     = InjectParameterDataRequestData;
@@ -214,13 +323,134 @@ struct InjectParameterDataRequestData {
 	};
 };
 
-void setParameters(ws::IController&             wsController,
-                   std::vector<ParameterValue>& values) {
+static constexpr std::string_view EMPTY_VALUES      = "[]";
+static constexpr std::string_view REQUEST_ID_KEY    = R"("requestID":")";
+static constexpr std::string_view ID_KEY            = R"({"id":")";
+static constexpr std::string_view VALUE_KEY         = R"(","value":)";
+static constexpr int              MAX_PRECISION     = 9;
+static constexpr std::size_t      MAX_NUMBER_LENGTH = 64;
+
+// The envelope is rendered with an empty request id and split around it and
+// around the empty value array, leaving three constant pieces.
+InjectionEncoder::InjectionEncoder(const int precision) :
+    _head(),
+    _prefix(),
+    _suffix(),
+    _precision(0) {
+	setPrecision(precision);
+
 	const Request<InjectParameterDataRequestData> request(
-	    "InjectParameterDataRequest",
-	    InjectParameterDataRequestData{.parameterValues = std::move(values)});
-	if (auto message = stringify(request)) {
-		wsController.sendMessage(std::move(*message));
+	    RequestType::INJECT_PARAMETER_DATA,
+	    InjectParameterDataRequestData());
+	const auto envelope = stringify(request);
+	if (!envelope) {
+		return;
+	}
+	const auto id    = envelope->find(REQUEST_ID_KEY) + REQUEST_ID_KEY.size();
+	const auto split = envelope->rfind(EMPTY_VALUES);
+	_head            = envelope->substr(0, id);
+	_prefix          = envelope->substr(id, split + 1 - id);
+	_suffix          = envelope->substr(split + 1);
+}
+
+void InjectionEncoder::encode(const Uint64                          requestId,
+                              const std::span<const ParameterValue> values,
+                              std::string& buffer) const {
+	char number[MAX_NUMBER_LENGTH];
+	buffer.clear();
+	buffer.append(_head);
+	const auto [idEnd, idError] =
+	    std::to_chars(number, number + sizeof(number), requestId);
+	if (idError == std::errc{}) {
+		buffer.append(number, idEnd);
+	}
+	buffer.append(_prefix);
+	for (std::size_t i = 0; i < values.size(); ++i) {
+		if (i > 0) {
+			buffer.push_back(',');
+		}
+		buffer.append(ID_KEY);
+		buffer.append(values[i].id);
+		buffer.append(VALUE_KEY);
+		float value = values[i].value;
+		if (!std::isfinite(value)) {
+			value = 0.0F;
+		}
+		const auto [end, error] = std::to_chars(number,
+		                                        number + sizeof(number),
+		                                        value,
+		                                        std::chars_format::fixed,
+		                                        _precision);
+		if (error == std::errc{}) {
+			buffer.append(number, end);
+		}
+		else {
+			buffer.push_back('0');
+		}
+		buffer.push_back('}');
+	}
+	buffer.append(_suffix);
+}
+
+void InjectionEncoder::setPrecision(const int precision) {
+	_precision = std::clamp(precision, 0, MAX_PRECISION);
+}
+
+// VTS rejects injections before authentication, and a closed socket has
+// nowhere to send them.
+static bool canInject(ws::IController& wsController) {
+	return wsController.getStatus() == ws::Status::AUTHENTICATED;
+}
+
+static Uint64 encodeInjection(ws::IController&                wsController,
+                              const InjectionEncoder&         encoder,
+                              std::span<const ParameterValue> values,
+                              std::string&                    message) {
+	const Uint64 id = REQUESTS.begin(RequestType::INJECT_PARAMETER_DATA,
+	                                 wsController.getInstance(),
+	                                 SDL_GetTicksNS());
+	message         = wsController.acquireBuffer();
+	encoder.encode(id, values, message);
+	return id;
+}
+
+// A frame replaced before it was sent will never be answered, so its id is
+// dropped rather than left to time out.
+void setParameters(ws::IController&                      wsController,
+                   const InjectionEncoder&               encoder,
+                   const std::span<const ParameterValue> values) {
+	if (!canInject(wsController)) {
+		return;
+	}
+	std::string  message;
+	const Uint64 id = encodeInjection(wsController, encoder, values, message);
+	REQUESTS.cancel(wsController.sendInjection(id, std::move(message)));
+}
+
+// The request is rendered for the first connection that can take it and the
+// same bytes are queued on the rest, so its id is tracked against that first
+// connection only.
+void setParameters(std::span<ws::IController* const>     wsControllers,
+                   const InjectionEncoder&               encoder,
+                   const std::span<const ParameterValue> values) {
+	if (wsControllers.size() == 1) {
+		setParameters(*wsControllers.front(), encoder, values);
+		return;
+	}
+	std::shared_ptr<const std::string> message;
+	Uint64                             id = 0;
+	for (auto* wsController : wsControllers) {
+		if (!canInject(*wsController)) {
+			continue;
+		}
+		if (!message) {
+			std::string buffer;
+			id      = encodeInjection(*wsController, encoder, values, buffer);
+			message = std::make_shared<const std::string>(std::move(buffer));
+			REQUESTS.cancel(wsController->sendSharedInjection(id, message));
+			continue;
+		}
+		wsController->sendSharedInjection(id, message);
 	}
 }
 
@@ -0,0 +1,233 @@
+#include "vts/request_tracker.hpp"
+
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <cmath>
+#include <cstddef>
+#include <iterator>
+#include <string_view>
+
+#include <SDL3/SDL_log.h>
+#include <SDL3/SDL_stdinc.h>
+
+namespace vts {
+
+static constexpr Uint64 NS_PER_US          = 1000;
+static constexpr Uint64 REQUEST_TIMEOUT_NS = 5'000'000'000;
+
+// A token is only issued once the user confirms VTS's permission popup.
+static constexpr Uint64 TOKEN_TIMEOUT_NS = 120'000'000'000;
+
+static constexpr std::string_view MESSAGE_TYPES[] = {
+    "AuthenticationRequest",
+    "AuthenticationTokenRequest",
+    "InputParameterListRequest",
+    "ParameterCreationRequest",
+    "ParameterDeletionRequest",
+    "InjectParameterDataRequest",
+    "EventSubscriptionRequest",
+    "ItemListRequest",
+    "ItemMoveRequest",
+};
+
+static_assert(std::size(MESSAGE_TYPES) == N_REQUEST_TYPES);
+
+static constexpr std::size_t toIndex(const RequestType type) {
+	return static_cast<std::size_t>(type);
+}
+
+std::string_view getMessageType(const RequestType type) {
+	return MESSAGE_TYPES[toIndex(type)];
+}
+
+LatencyHistogram::LatencyHistogram() :
+    _counts(),
+    _total(0),
+    _maxUs(0) {}
+
+std::size_t LatencyHistogram::getBucket(const Uint64 us) {
+	if (us < SUB_BUCKETS) {
+		return us;
+	}
+	const auto   octave = static_cast<Uint64>(std::bit_width(us) - 1);
+	const Uint64 sub    = (us >> (octave - 3)) & (SUB_BUCKETS - 1);
+	const Uint64 bucket = (octave - 2) * SUB_BUCKETS + sub;
+	return static_cast<std::size_t>(std::min<Uint64>(bucket, N_BUCKETS - 1));
+}
+
+Uint64 LatencyHistogram::getUpperBound(const std::size_t bucket) {
+	if (bucket < SUB_BUCKETS) {
+		return bucket;
+	}
+	const Uint64 shift = bucket / SUB_BUCKETS - 1;
+	const Uint64 lower = (SUB_BUCKETS + bucket % SUB_BUCKETS) << shift;
+	return lower + (Uint64{1} << shift) - 1;
+}
+
+Uint64 LatencyHistogram::getCount() const {
+	return _total;
+}
+
+Uint64 LatencyHistogram::getMaxUs() const {
+	return _maxUs;
+}
+
+// Reports the upper edge of the bucket holding the percentile, so the result
+// overestimates by at most one bucket width.
+Uint64 LatencyHistogram::getPercentileUs(const double percentile) const {
+	if (_total == 0) {
+		return 0;
+	}
+	const double clamped = std::clamp(percentile, 0.0, 1.0);
+	const double rank    = std::ceil(clamped * static_cast<double>(_total));
+	const Uint64 target  = std::max<Uint64>(1, static_cast<Uint64>(rank));
+	Uint64       seen    = 0;
+	for (std::size_t i = 0; i < N_BUCKETS; ++i) {
+		seen += _counts[i];
+		if (seen >= target) {
+			return std::min(getUpperBound(i), _maxUs);
+		}
+	}
+	return _maxUs;
+}
+
+void LatencyHistogram::clear() {
+	_counts.fill(0);
+	_total = 0;
+	_maxUs = 0;
+}
+
+void LatencyHistogram::record(const Uint64 us) {
+	++_counts[getBucket(us)];
+	++_total;
+	_maxUs = std::max(_maxUs, us);
+}
+
+RequestTracker::RequestTracker() :
+    _nextId(1),
+    _inFlightCount(0),
+    _inFlight(),
+    _histograms(),
+    _timeouts() {}
+
+RequestTracker::InFlight* RequestTracker::find(const Uint64 id) {
+	InFlight& slot = _inFlight[id % N_SLOTS];
+	return id != 0 && slot.id == id ? &slot : nullptr;
+}
+
+void RequestTracker::release(InFlight& slot) {
+	slot.id = 0;
+	--_inFlightCount;
+}
+
+RequestTracker& RequestTracker::instance() {
+	static RequestTracker instance;
+	return instance;
+}
+
+const LatencyHistogram& RequestTracker::getHistogram(
+    const RequestType type) const {
+	return _histograms[toIndex(type)];
+}
+
+std::size_t RequestTracker::getInFlight() const {
+	return _inFlightCount;
+}
+
+Uint64 RequestTracker::getTimeouts(const RequestType type) const {
+	return _timeouts[toIndex(type)];
+}
+
+bool RequestTracker::isInFlight(const Uint64 id) const {
+	return id != 0 && _inFlight[id % N_SLOTS].id == id;
+}
+
+Uint64 RequestTracker::begin(const RequestType type,
+                             const std::size_t instance,
+                             const Uint64      nowNs) {
+	Uint64    id   = _nextId++;
+	InFlight* slot = &_inFlight[id % N_SLOTS];
+	for (std::size_t i = 1; i < N_SLOTS && slot->id != 0; ++i) {
+		id   = _nextId++;
+		slot = &_inFlight[id % N_SLOTS];
+	}
+	if (slot->id != 0) {
+		// Every slot is waiting on a response; the oldest one is given up on.
+		++_timeouts[toIndex(slot->type)];
+	}
+	else {
+		++_inFlightCount;
+	}
+	*slot = {.id = id, .sentNs = nowNs, .instance = instance, .type = type};
+	return id;
+}
+
+void RequestTracker::cancel(const Uint64 id) {
+	InFlight* slot = find(id);
+	if (slot != nullptr) {
+		release(*slot);
+	}
+}
+
+// Responses to requests sent over a dropped connection will never arrive, so
+// they are forgotten instead of being reported as timeouts.
+void RequestTracker::clearInFlight(const std::size_t instance) {
+	for (auto& slot : _inFlight) {
+		if (slot.id != 0 && slot.instance == instance) {
+			release(slot);
+		}
+	}
+}
+
+void RequestTracker::clearStatistics() {
+	for (auto& histogram : _histograms) {
+		histogram.clear();
+	}
+	_timeouts.fill(0);
+}
+
+bool RequestTracker::complete(const Uint64 id, const Uint64 nowNs) {
+	InFlight* slot = find(id);
+	if (slot == nullptr) {
+		return false;
+	}
+	const Uint64 rttNs = nowNs - slot->sentNs;
+	_histograms[toIndex(slot->type)].record(rttNs / NS_PER_US);
+	release(*slot);
+	return true;
+}
+
+void RequestTracker::expire(const Uint64 nowNs) {
+	if (_inFlightCount == 0) {
+		return;
+	}
+	std::array<Uint64, N_REQUEST_TYPES> expired{};
+	for (auto& slot : _inFlight) {
+		if (slot.id == 0) {
+			continue;
+		}
+		const Uint64 timeoutNs = slot.type == RequestType::AUTHENTICATION_TOKEN
+		                             ? TOKEN_TIMEOUT_NS
+		                             : REQUEST_TIMEOUT_NS;
+		if (nowNs - slot.sentNs < timeoutNs) {
+			continue;
+		}
+		++expired[toIndex(slot.type)];
+		release(slot);
+	}
+	for (std::size_t i = 0; i < N_REQUEST_TYPES; ++i) {
+		if (expired[i] == 0) {
+			continue;
+		}
+		_timeouts[i] += expired[i];
+		const auto type = getMessageType(static_cast<RequestType>(i));
+		SDL_LogError(SDL_LOG_CATEGORY_APPLICATION,
+		             "%llu %.*s(s) timed out without a response",
+		             static_cast<unsigned long long>(expired[i]),
+		             static_cast<int>(type.size()),
+		             type.data());
+	}
+}
+
+}  // namespace vts
@@ -2,9 +2,12 @@
 
 #include <iostream>
 
+#include <charconv>
+#include <cstddef>
 #include <cstdint>
 #include <optional>
 #include <string>
+#include <string_view>
 #include <utility>
 #include <vector>
 
@@ -17,8 +20,11 @@
 #include <glaze/json/read.hpp>
 
 #include "core/meta.hpp"
+#include "core/utility.hpp"
+#include "vts/item.hpp"
+#include "vts/model_cache.hpp"
 
-static void logError(const glz::error_ctx& error, const std::string& buffer) {
+static void logError(const glz::error_ctx& error, std::string_view buffer) {
 	std::cerr
 	    << "Error reading response: "
 	    << glz::format_error(error, buffer)
@@ -26,14 +32,61 @@ static void logError(const glz::error_ctx& error, const std::string& buffer) {
 }
 
 struct Type {
-	static constexpr auto API_ERROR            = "APIError";
-	static constexpr auto AUTHENTICATION_TOKEN = "AuthenticationTokenResponse";
-	static constexpr auto AUTHENTICATION       = "AuthenticationResponse";
-	static constexpr auto INPUT_PARAMETER_LIST = "InputParameterListResponse";
-	static constexpr auto PARAMETER_CREATION   = "ParameterCreationResponse";
-	static constexpr auto PARAMETER_DELETION   = "ParameterDeletionResponse";
+	static constexpr std::string_view API_ERROR = "APIError";
+	static constexpr std::string_view AUTHENTICATION_TOKEN =
+	    "AuthenticationTokenResponse";
+	static constexpr std::string_view AUTHENTICATION = "AuthenticationResponse";
+	static constexpr std::string_view INPUT_PARAMETER_LIST =
+	    "InputParameterListResponse";
+	static constexpr std::string_view PARAMETER_CREATION =
+	    "ParameterCreationResponse";
+	static constexpr std::string_view PARAMETER_DELETION =
+	    "ParameterDeletionResponse";
+	static constexpr std::string_view EVENT_SUBSCRIPTION =
+	    "EventSubscriptionResponse";
+	static constexpr std::string_view MODEL_LOADED = "ModelLoadedEvent";
+	static constexpr std::string_view MODEL_CONFIG_CHANGED =
+	    "ModelConfigChangedEvent";
+	static constexpr std::string_view ITEM_LIST  = "ItemListResponse";
+	static constexpr std::string_view ITEM_EVENT = "ItemEvent";
 };
 
+// FNV-1a, used to switch on messageType instead of comparing against every
+// known type in turn. A hit is still confirmed with a full comparison.
+static constexpr std::uint32_t hashType(const std::string_view type) {
+	std::uint32_t hash = 2166136261U;
+	for (const char c : type) {
+		hash ^= static_cast<unsigned char>(c);
+		hash *= 16777619U;
+	}
+	return hash;
+}
+
+static constexpr std::string_view MESSAGE_TYPE_KEY = "\"messageType\"";
+static constexpr std::string_view REQUEST_ID_KEY   = "\"requestID\"";
+
+// VTS writes the envelope ahead of "data", so its fields are found near the
+// start of the frame without tokenizing the payload. Neither the type names
+// nor our request ids contain escapes, which lets a value be taken as-is
+// between the quotes.
+static std::string_view scanEnvelope(const std::string_view json,
+                                     const std::string_view key) {
+	const auto position = json.find(key);
+	if (position == std::string_view::npos) {
+		return {};
+	}
+	auto i = json.find_first_not_of(" \t\r\n:", position + key.size());
+	if (i == std::string_view::npos || json[i] != '"') {
+		return {};
+	}
+	++i;
+	const auto end = json.find('"', i);
+	if (end == std::string_view::npos) {
+		return {};
+	}
+	return json.substr(i, end - i);
+}
+
 namespace vts {
 
 struct BaseResponse {
@@ -79,14 +132,23 @@ struct Response : BaseResponse {
 	};
 };
 
+// The frame is read in place: mongoose does not terminate it, so glaze is
+// told to stop at the end of the view rather than at a '\0'.
+static constexpr glz::opts FRAME_OPTS{.null_terminated       = false,
+                                      .error_on_unknown_keys = false};
+
 template <typename ResponseType>
-std::optional<ResponseType> parseResponse(const std::string& jsonString) {
-	auto result = glz::read_json<ResponseType>(jsonString);
-	if (result) {
-		return result.value();
+std::optional<ResponseType> parseResponse(const std::string_view json) {
+	ResponseType response;
+	auto         error = glz::read<FRAME_OPTS>(response, json);
+	if (error) {
+		logError(error, json);
+		return std::nullopt;
+	}
+	if (!response.data) {
+		return std::nullopt;
 	}
-	logError(result.error(), jsonString);
-	return std::nullopt;
+	return response;
 }
 
 struct APIErrorResponseData {
@@ -196,16 +258,22 @@ struct InputParameterListResponseData {
 
 using InputParameterListResponse = Response<InputParameterListResponseData>;
 
-void buildInputParameterListEvent(SDL_UserEvent&                        event,
-                                  const InputParameterListResponseData& data) {
-	auto* parameters = new std::vector<std::string>();
-	for (const auto& parameter : data.customParameters) {
+void buildInputParameterListEvent(SDL_UserEvent&                  event,
+                                  InputParameterListResponseData& data) {
+	auto* list = new ParameterList{.modelLoaded = data.modelLoaded,
+	                               .modelId     = std::move(data.modelId),
+	                               .modelName   = std::move(data.modelName),
+	                               .parameters  = {}};
+	for (auto& parameter : data.customParameters) {
 		if (parameter.addedBy == core::PLUGIN_NAME) {
-			parameters->emplace_back(std::move(parameter.name));
+			list->parameters.push_back({.name         = std::move(parameter.name),
+			                            .min          = parameter.min,
+			                            .max          = parameter.max,
+			                            .defaultValue = parameter.defaultValue});
 		}
 	}
 	event.code  = ResponseCode::INPUT_PARAMETER_LIST;
-	event.data1 = parameters;
+	event.data1 = list;
 }
 
 struct ParameterCreationResponseData {
@@ -219,9 +287,10 @@ struct ParameterCreationResponseData {
 
 using ParameterCreationResponse = Response<ParameterCreationResponseData>;
 
-void buildParameterCreationEvent(SDL_UserEvent& event,
-                                 const ParameterCreationResponseData&) {
-	event.code = ResponseCode::PARAMETER_CREATION;
+void buildParameterCreationEvent(SDL_UserEvent&                       event,
+                                 const ParameterCreationResponseData& data) {
+	event.code  = ResponseCode::PARAMETER_CREATION;
+	event.data1 = new std::string(data.parameterName);
 }
 
 struct ParameterDeletionResponseData {
@@ -240,53 +309,257 @@ void buildParameterDeletionEvent(SDL_UserEvent& event,
 	event.code = ResponseCode::PARAMETER_DELETION;
 }
 
-void buildResponseEvent(SDL_UserEvent& event,
-                        char*          jsonChars,
-                        const int      nChars) {
-	std::string jsonString(jsonChars, nChars);
+struct EventSubscriptionResponseData {
+	int                      subscribedEventCount = 0;
+	std::vector<std::string> subscribedEvents;
 
-	BaseResponse base;
-	auto         baseError =
-	    glz::read<glz::opts{.error_on_unknown_keys = false}>(base, jsonString);
-	if (baseError) {
-		logError(baseError, jsonString);
-		return;
+	struct glaze {
+		using T                     = EventSubscriptionResponseData;
+		static constexpr auto value = glz::object("subscribedEventCount",
+		                                          &T::subscribedEventCount,
+		                                          "subscribedEvents",
+		                                          &T::subscribedEvents);
+	};
+};
+
+using EventSubscriptionResponse = Response<EventSubscriptionResponseData>;
+
+void buildEventSubscriptionEvent(SDL_UserEvent& event,
+                                 const EventSubscriptionResponseData&) {
+	event.code = ResponseCode::EVENT_SUBSCRIPTION;
+}
+
+struct ModelLoadedEventData {
+	bool        modelLoaded = false;
+	std::string modelName;
+	std::string modelId;
+
+	struct glaze {
+		using T                     = ModelLoadedEventData;
+		static constexpr auto value = glz::object("modelLoaded",
+		                                          &T::modelLoaded,
+		                                          "modelName",
+		                                          &T::modelName,
+		                                          "modelID",
+		                                          &T::modelId);
+	};
+};
+
+using ModelLoadedEvent = Response<ModelLoadedEventData>;
+
+void buildModelLoadedEvent(SDL_UserEvent& event, ModelLoadedEventData& data) {
+	event.code  = ResponseCode::MODEL_LOADED;
+	event.data1 = new ModelStatus{.modelLoaded = data.modelLoaded,
+	                              .modelId     = std::move(data.modelId),
+	                              .modelName   = std::move(data.modelName)};
+}
+
+struct ModelConfigChangedEventData {
+	std::string modelId;
+	std::string modelName;
+
+	struct glaze {
+		using T                     = ModelConfigChangedEventData;
+		static constexpr auto value = glz::object("modelID",
+		                                          &T::modelId,
+		                                          "modelName",
+		                                          &T::modelName);
+	};
+};
+
+using ModelConfigChangedEvent = Response<ModelConfigChangedEventData>;
+
+void buildModelConfigChangedEvent(SDL_UserEvent& event,
+                                  const ModelConfigChangedEventData&) {
+	event.code = ResponseCode::MODEL_CONFIG_CHANGED;
+}
+
+struct IncomingItem {
+	std::string fileName;
+	std::string instanceId;
+
+	struct glaze {
+		using T                     = IncomingItem;
+		static constexpr auto value = glz::object("fileName",
+		                                          &T::fileName,
+		                                          "instanceID",
+		                                          &T::instanceId);
+	};
+};
+
+struct ItemListResponseData {
+	std::vector<IncomingItem> itemInstancesInScene;
+
+	struct glaze {
+		using T                     = ItemListResponseData;
+		static constexpr auto value = glz::object("itemInstancesInScene",
+		                                          &T::itemInstancesInScene);
+	};
+};
+
+using ItemListResponse = Response<ItemListResponseData>;
+
+void buildItemListEvent(SDL_UserEvent& event, ItemListResponseData& data) {
+	auto* items = new std::vector<ItemInstance>();
+	items->reserve(data.itemInstancesInScene.size());
+	for (auto& item : data.itemInstancesInScene) {
+		items->push_back({.fileName   = std::move(item.fileName),
+		                  .instanceId = std::move(item.instanceId)});
 	}
+	event.code  = ResponseCode::ITEM_LIST;
+	event.data1 = items;
+}
 
-	const std::string& messageType = base.messageType;
+struct ItemEventData {
+	std::string itemEventType;
+	std::string itemInstanceId;
+	std::string itemFileName;
 
-	event.code = ResponseCode::UNKNOWN;
+	struct glaze {
+		using T                     = ItemEventData;
+		static constexpr auto value = glz::object("itemEventType",
+		                                          &T::itemEventType,
+		                                          "itemInstanceID",
+		                                          &T::itemInstanceId,
+		                                          "itemFileName",
+		                                          &T::itemFileName);
+	};
+};
 
-	if (messageType == Type::API_ERROR) {
-		if (auto response = parseResponse<APIErrorResponse>(jsonString)) {
-			buildApiErrorEvent(event, *(response->data));
-		}
+using ItemEvent = Response<ItemEventData>;
+
+// Only loads and unloads matter to bindings; clicks, drops and locks are left
+// as UNKNOWN.
+void buildItemEvent(SDL_UserEvent& event, ItemEventData& data) {
+	if (data.itemEventType == "Added") {
+		event.code = ResponseCode::ITEM_ADDED;
 	}
-	if (messageType == Type::AUTHENTICATION) {
-		if (auto response = parseResponse<AuthenticationResponse>(jsonString)) {
-			buildAuthenticationEvent(event, *(response->data));
-		}
+	else if (data.itemEventType == "Removed") {
+		event.code = ResponseCode::ITEM_REMOVED;
 	}
-	else if (messageType == Type::AUTHENTICATION_TOKEN) {
-		if (auto response = parseResponse<AuthenticationTokenResponse>(jsonString)) {
-			buildAuthenticationTokenEvent(event, *(response->data));
-		}
+	else {
+		return;
 	}
-	else if (messageType == Type::INPUT_PARAMETER_LIST) {
-		if (auto response = parseResponse<InputParameterListResponse>(jsonString)) {
-			buildInputParameterListEvent(event, *(response->data));
-		}
+	event.data1 = new ItemInstance{.fileName   = std::move(data.itemFileName),
+	                               .instanceId = std::move(data.itemInstanceId)};
+}
+
+template <typename ResponseType, typename BuildFn>
+static void decode(SDL_UserEvent&         event,
+                   const std::string_view json,
+                   BuildFn                build) {
+	if (auto response = parseResponse<ResponseType>(json)) {
+		build(event, *(response->data));
 	}
-	else if (messageType == Type::PARAMETER_CREATION) {
-		if (auto response = parseResponse<ParameterCreationResponse>(jsonString)) {
-			buildParameterCreationEvent(event, *(response->data));
-		}
+}
+
+void buildResponseEvent(SDL_UserEvent& event, const std::string_view json) {
+	event.code = ResponseCode::UNKNOWN;
+
+	// Events and frames answering someone else's request carry no numeric id
+	// and leave data2 at 0, which the tracker never issues.
+	const std::string_view requestId = scanEnvelope(json, REQUEST_ID_KEY);
+	std::uint64_t          id        = 0;
+	std::from_chars(requestId.data(), requestId.data() + requestId.size(), id);
+	event.data2 = core::unsignedToPointer(id);
+
+	const std::string_view messageType = scanEnvelope(json, MESSAGE_TYPE_KEY);
+	switch (hashType(messageType)) {
+		case hashType(Type::API_ERROR):
+			if (messageType == Type::API_ERROR) {
+				decode<APIErrorResponse>(event, json, buildApiErrorEvent);
+			}
+			break;
+		case hashType(Type::AUTHENTICATION):
+			if (messageType == Type::AUTHENTICATION) {
+				decode<AuthenticationResponse>(event, json, buildAuthenticationEvent);
+			}
+			break;
+		case hashType(Type::AUTHENTICATION_TOKEN):
+			if (messageType == Type::AUTHENTICATION_TOKEN) {
+				decode<AuthenticationTokenResponse>(event,
+				                                    json,
+				                                    buildAuthenticationTokenEvent);
+			}
+			break;
+		case hashType(Type::INPUT_PARAMETER_LIST):
+			if (messageType == Type::INPUT_PARAMETER_LIST) {
+				decode<InputParameterListResponse>(event,
+				                                   json,
+				                                   buildInputParameterListEvent);
+			}
+			break;
+		case hashType(Type::PARAMETER_CREATION):
+			if (messageType == Type::PARAMETER_CREATION) {
+				decode<ParameterCreationResponse>(event,
+				                                  json,
+				                                  buildParameterCreationEvent);
+			}
+			break;
+		case hashType(Type::PARAMETER_DELETION):
+			if (messageType == Type::PARAMETER_DELETION) {
+				decode<ParameterDeletionResponse>(event,
+				                                  json,
+				                                  buildParameterDeletionEvent);
+			}
+			break;
+		case hashType(Type::EVENT_SUBSCRIPTION):
+			if (messageType == Type::EVENT_SUBSCRIPTION) {
+				decode<EventSubscriptionResponse>(event,
+				                                  json,
+				                                  buildEventSubscriptionEvent);
+			}
+			break;
+		case hashType(Type::MODEL_LOADED):
+			if (messageType == Type::MODEL_LOADED) {
+				decode<ModelLoadedEvent>(event, json, buildModelLoadedEvent);
+			}
+			break;
+		case hashType(Type::ITEM_LIST):
+			if (messageType == Type::ITEM_LIST) {
+				decode<ItemListResponse>(event, json, buildItemListEvent);
+			}
+			break;
+		case hashType(Type::ITEM_EVENT):
+			if (messageType == Type::ITEM_EVENT) {
+				decode<ItemEvent>(event, json, buildItemEvent);
+			}
+			break;
+		case hashType(Type::MODEL_CONFIG_CHANGED):
+			if (messageType == Type::MODEL_CONFIG_CHANGED) {
+				decode<ModelConfigChangedEvent>(event,
+				                                json,
+				                                buildModelConfigChangedEvent);
+			}
+			break;
+		default:
+			break;
 	}
-	else if (messageType == Type::PARAMETER_DELETION) {
-		if (auto response = parseResponse<ParameterDeletionResponse>(jsonString)) {
-			buildParameterDeletionEvent(event, *(response->data));
-		}
+}
+
+void releaseResponse(SDL_UserEvent& event) {
+	switch (event.code) {
+		case ResponseCode::AUTHENTICATION_TOKEN:
+		case ResponseCode::PARAMETER_CREATION:
+			delete static_cast<std::string*>(event.data1);
+			break;
+		case ResponseCode::INPUT_PARAMETER_LIST:
+			delete static_cast<ParameterList*>(event.data1);
+			break;
+		case ResponseCode::MODEL_LOADED:
+			delete static_cast<ModelStatus*>(event.data1);
+			break;
+		case ResponseCode::ITEM_LIST:
+			delete static_cast<std::vector<ItemInstance>*>(event.data1);
+			break;
+		case ResponseCode::ITEM_ADDED:
+		case ResponseCode::ITEM_REMOVED:
+			delete static_cast<ItemInstance*>(event.data1);
+			break;
+		default:
+			break;
 	}
+	event.data1 = nullptr;
 }
 
 }  // namespace vts
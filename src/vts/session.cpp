@@ -0,0 +1,121 @@
+#include "vts/session.hpp"
+
+#include <coroutine>
+#include <utility>
+#include <vector>
+
+#include <SDL3/SDL_events.h>
+#include <SDL3/SDL_stdinc.h>
+
+#include "core/utility.hpp"
+#include "vts/request_tracker.hpp"
+#include "vts/response.hpp"
+
+namespace vts {
+
+static SDL_UserEvent makeUnknownResponse() {
+	SDL_UserEvent response;
+	SDL_zero(response);
+	response.code = ResponseCode::UNKNOWN;
+	return response;
+}
+
+PendingResponse::PendingResponse(Session& session, const Uint64 id) :
+    _session(session),
+    _id(id) {
+	_session._slots.emplace(
+	    _id,
+	    Session::Slot{.waiter = {}, .response = {}, .isReady = false});
+}
+
+PendingResponse::~PendingResponse() {
+	const auto it = _session._slots.find(_id);
+	if (it == _session._slots.end()) {
+		return;
+	}
+	if (it->second.isReady) {
+		releaseResponse(it->second.response);
+	}
+	_session._slots.erase(it);
+}
+
+bool PendingResponse::await_ready() const {
+	const auto it = _session._slots.find(_id);
+	return it == _session._slots.end() || it->second.isReady;
+}
+
+void PendingResponse::await_suspend(const std::coroutine_handle<> waiter) {
+	_session._slots[_id].waiter = waiter;
+}
+
+SDL_UserEvent PendingResponse::await_resume() {
+	const auto it = _session._slots.find(_id);
+	if (it == _session._slots.end()) {
+		return makeUnknownResponse();
+	}
+	const SDL_UserEvent response = it->second.response;
+	_session._slots.erase(it);
+	return response;
+}
+
+Session::Session() :
+    _slots() {}
+
+Session::~Session() {
+	cancel();
+}
+
+void Session::resolve(const Uint64 id, const SDL_UserEvent& response) {
+	const auto it = _slots.find(id);
+	if (it == _slots.end()) {
+		return;
+	}
+	it->second.response = response;
+	it->second.isReady  = true;
+	const auto waiter   = std::exchange(it->second.waiter, {});
+	if (waiter) {
+		waiter.resume();
+	}
+}
+
+// Destroys every suspended flow without resuming it, e.g. when the socket
+// reconnects and a fresh handshake supersedes the old one.
+void Session::cancel() {
+	auto slots = std::move(_slots);
+	_slots.clear();
+	for (auto& [id, slot] : slots) {
+		if (slot.isReady) {
+			releaseResponse(slot.response);
+		}
+		if (slot.waiter) {
+			slot.waiter.destroy();
+		}
+	}
+}
+
+bool Session::deliver(const SDL_UserEvent& response) {
+	const auto id = core::pointerToUnsigned<Uint64>(response.data2);
+	if (id == 0 || !_slots.contains(id)) {
+		return false;
+	}
+	resolve(id, response);
+	return true;
+}
+
+PendingResponse Session::expect(const Uint64 id) {
+	return {*this, id};
+}
+
+void Session::expire() {
+	std::vector<Uint64> expired;
+	for (const auto& [id, slot] : _slots) {
+		if (!slot.isReady && !REQUESTS.isInFlight(id)) {
+			expired.push_back(id);
+		}
+	}
+	for (const Uint64 id : expired) {
+		resolve(id, makeUnknownResponse());
+	}
+}
+
+}  // namespace vts
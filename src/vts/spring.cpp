@@ -0,0 +1,150 @@
+#include "vts/spring.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <numbers>
+#include <span>
+
+#include <SDL3/SDL_stdinc.h>
+
+namespace vts {
+
+static constexpr Uint64 SUBSTEP_NS      = SDL_MS_TO_NS(1);
+static constexpr Uint64 MAX_CATCH_UP_NS = SDL_MS_TO_NS(250);
+static constexpr float  SUBSTEP_S =
+    static_cast<float>(SUBSTEP_NS) / SDL_NS_PER_SECOND;
+static constexpr float SETTLE_DISTANCE = 0.00001F;
+static constexpr float SETTLE_VELOCITY = 0.0001F;
+
+static constexpr float calcStiffness(const float frequency) {
+	const float omega = 2.0F * std::numbers::pi_v<float> * frequency;
+	return omega * omega;
+}
+
+static constexpr float calcDamping(const float frequency, const float ratio) {
+	return 4.0F * std::numbers::pi_v<float> * frequency * ratio;
+}
+
+// Semi-implicit Euler: velocity first, then position from the new velocity.
+// Stable for the clamped frequency range at a 1 ms substep.
+static constexpr void integrateOne(float&      position,
+                                   float&      velocity,
+                                   const float target,
+                                   const float stiffness,
+                                   const float damping) {
+	const float acceleration =
+	    stiffness * (target - position) - damping * velocity;
+	velocity += acceleration * SUBSTEP_S;
+	position += velocity * SUBSTEP_S;
+}
+
+void SpringBank::integrate(const std::size_t steps) {
+	const std::size_t n          = _positions.size();
+	const float*      stiffness  = _stiffnesses.data();
+	const float*      damping    = _dampings.data();
+	const float*      targets    = _targets.data();
+	float*            positions  = _positions.data();
+	float*            velocities = _velocities.data();
+	for (std::size_t s = 0; s < steps; ++s) {
+		for (std::size_t i = 0; i < n; ++i) {
+			integrateOne(positions[i],
+			             velocities[i],
+			             targets[i],
+			             stiffness[i],
+			             damping[i]);
+		}
+	}
+}
+
+void SpringBank::settle() {
+	for (std::size_t i = 0; i < _positions.size(); ++i) {
+		if (std::abs(_targets[i] - _positions[i]) < SETTLE_DISTANCE
+		    && std::abs(_velocities[i]) < SETTLE_VELOCITY) {
+			_positions[i]  = _targets[i];
+			_velocities[i] = 0.0F;
+		}
+	}
+}
+
+SpringBank::SpringBank() :
+    _owners(),
+    _stiffnesses(),
+    _dampings(),
+    _positions(),
+    _velocities(),
+    _targets(),
+    _accumulatorNs(0),
+    _lastTickNs(0) {}
+
+std::span<const std::size_t> SpringBank::owners() const {
+	return _owners;
+}
+
+std::span<const float> SpringBank::positions() const {
+	return _positions;
+}
+
+std::span<float> SpringBank::targets() {
+	return _targets;
+}
+
+void SpringBank::integrateSingle(SpringState&      state,
+                                 const float       frequency,
+                                 const float       damping,
+                                 const float       target,
+                                 const std::size_t steps) {
+	const float stiffness   = calcStiffness(frequency);
+	const float dampingCoef = calcDamping(frequency, damping);
+	for (std::size_t s = 0; s < steps; ++s) {
+		integrateOne(state.position,
+		             state.velocity,
+		             target,
+		             stiffness,
+		             dampingCoef);
+	}
+	if (std::abs(target - state.position) < SETTLE_DISTANCE
+	    && std::abs(state.velocity) < SETTLE_VELOCITY) {
+		state = {.position = target, .velocity = 0.0F};
+	}
+}
+
+void SpringBank::add(const std::size_t owner,
+                     const float       frequency,
+                     const float       damping,
+                     const float       position) {
+	_owners.push_back(owner);
+	_stiffnesses.push_back(calcStiffness(frequency));
+	_dampings.push_back(calcDamping(frequency, damping));
+	_positions.push_back(position);
+	_velocities.push_back(0.0F);
+	_targets.push_back(position);
+}
+
+void SpringBank::clear() {
+	_owners.clear();
+	_stiffnesses.clear();
+	_dampings.clear();
+	_positions.clear();
+	_velocities.clear();
+	_targets.clear();
+}
+
+std::size_t SpringBank::step(const Uint64 nowNs) {
+	if (_lastTickNs == 0) {
+		_lastTickNs = nowNs;
+		return 0;
+	}
+	_accumulatorNs += std::min(nowNs - _lastTickNs, MAX_CATCH_UP_NS);
+	_lastTickNs = nowNs;
+
+	const std::size_t steps = _accumulatorNs / SUBSTEP_NS;
+	_accumulatorNs -= steps * SUBSTEP_NS;
+	if (steps > 0) {
+		integrate(steps);
+		settle();
+	}
+	return steps;
+}
+
+}  // namespace vts
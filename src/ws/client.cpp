@@ -1,13 +1,17 @@
 #include "ws/client.hpp"
 
+#include <cstddef>
 #include <format>
+#include <memory>
 #include <mutex>
+#include <string>
 #include <thread>
 #include <utility>
 
 #include <SDL3/SDL_events.h>
 #include <SDL3/SDL_log.h>
 #include <SDL3/SDL_stdinc.h>
+#include <SDL3/SDL_timer.h>
 #include <mongoose.h>
 
 #include "core/settings.hpp"
@@ -23,13 +27,40 @@
 
 namespace ws {
 
-Client::Client() :
+static constexpr int    POLL_TIMEOUT_MS = 64;
+static constexpr Uint64 NS_PER_US       = 1000;
+
+// Injection frames and bulk messages are held back while this much is still
+// waiting to reach the socket, so a stalled connection keeps only the newest
+// frame and a large request cannot bury the next one.
+static constexpr std::size_t MAX_BUFFERED_BYTES = 16 * 1024;
+
+// Bytes each lane may write per pass. A lane always gets at least one message,
+// and whatever is left waits for the next write event.
+static constexpr std::size_t CONTROL_BUDGET_BYTES = 4 * 1024;
+static constexpr std::size_t BULK_BUDGET_BYTES    = 8 * 1024;
+
+Client::Client(const std::size_t instance) :
+    _instance(instance),
     _alive(false),
     _status(Status::DISCONNECTED),
-    _url(SETTINGS.getWsUrl()),
+    _url(SETTINGS.getWsUrl(instance)),
     _thread(),
-    _sendMutex(),
-    _sendQueue() {
+    _controlQueue(),
+    _bulkQueue(),
+    _spareBuffers(),
+    _droppedMessages(0),
+    _injections(),
+    _injectionMiddle(0),
+    _injectionBack(1),
+    _injectionFront(2),
+    _droppedFrames(0),
+    _manager(nullptr),
+    _connectionId(0),
+    _wakers(0),
+    _isWakeupPending(false),
+    _statsMutex(),
+    _queueLatency() {
 	mg_log_set(MG_LL_DEBUG);
 }
 
@@ -48,9 +79,14 @@ void Client::handleEvent(mg_connection* connection,
 			break;
 		case MG_EV_WS_OPEN:
 			client->handleOpen();
+			client->flushLanes(connection);
+			break;
+		case MG_EV_WAKEUP:
+		case MG_EV_WRITE:
+			client->flushLanes(connection);
 			break;
 		case MG_EV_WS_MSG:
-			handleMessage(static_cast<mg_ws_message*>(eventData));
+			client->handleMessage(static_cast<mg_ws_message*>(eventData));
 			break;
 	}
 
@@ -63,7 +99,8 @@ void Client::handleMessage(mg_ws_message* message) {
 	SDL_Event sdlEvent;
 	SDL_zero(sdlEvent);
 	sdlEvent.type = Event::MESSAGE;
-	vts::buildResponseEvent(sdlEvent.user, message->data.buf, message->data.len);
+	setInstance(sdlEvent.user, _instance);
+	vts::buildResponseEvent(sdlEvent.user, {message->data.buf, message->data.len});
 	SDL_PushEvent(&sdlEvent);
 }
 
@@ -77,6 +114,7 @@ void Client::handleOpen() {
 	SDL_Event sdlEvent;
 	SDL_zero(sdlEvent);
 	sdlEvent.type = Event::OPEN;
+	setInstance(sdlEvent.user, _instance);
 	SDL_PushEvent(&sdlEvent);
 }
 
@@ -84,30 +122,167 @@ void Client::setStatus(const Status newStatus) {
 	_status = newStatus;
 }
 
+// Sends the newest injection frame once the connection has drained enough of
+// what it already has; otherwise the frame waits and may yet be replaced.
+void Client::drainLane(mg_connection*    connection,
+                       MessageQueue&     queue,
+                       const std::size_t budgetBytes) {
+	std::size_t written = 0;
+	Outgoing    outgoing;
+	while (written < budgetBytes && queue.tryPop(outgoing)) {
+		written += outgoing.shared ? outgoing.shared->size()
+		                           : outgoing.owned.size();
+		writeMessage(connection, outgoing);
+	}
+}
+
+void Client::flushInjection(mg_connection* connection) {
+	if (!connection->is_websocket || connection->send.len >= MAX_BUFFERED_BYTES) {
+		return;
+	}
+	Outgoing* frame = takeInjection();
+	if (frame != nullptr) {
+		writeMessage(connection, *frame);
+	}
+}
+
+// Runs on the socket thread when woken by a sender, so a queued message goes
+// out right away instead of waiting for the poll to time out, and again after
+// each write so lanes that ran out of budget carry on. The pending flag is
+// cleared first: anything pushed after that point sends a new wakeup.
+void Client::flushLanes(mg_connection* connection) {
+	_isWakeupPending = false;
+	if (!connection->is_websocket) {
+		return;
+	}
+	const Uint64 dropped = _droppedMessages.exchange(0);
+	if (dropped != 0) {
+		SDL_LogWarn(SDL_LOG_CATEGORY_APPLICATION,
+		            "Send queue was full; dropped %llu message(s)",
+		            static_cast<unsigned long long>(dropped));
+	}
+	flushInjection(connection);
+	drainLane(connection, _controlQueue, CONTROL_BUDGET_BYTES);
+	if (connection->send.len < MAX_BUFFERED_BYTES) {
+		drainLane(connection, _bulkQueue, BULK_BUDGET_BYTES);
+	}
+}
+
+// Summarizes the Send Queue histogram when a connection ends, so the
+// enqueue-to-wire time can be read from a headless run against the mock.
+void Client::logQueueLatency() {
+	const auto latency = getQueueLatency();
+	if (latency.getCount() == 0) {
+		return;
+	}
+	SDL_Log("%s send queue: %llu messages, p50 %llu us, p99 %llu us, "
+	        "max %llu us",
+	        _url.c_str(),
+	        static_cast<unsigned long long>(latency.getCount()),
+	        static_cast<unsigned long long>(latency.getPercentileUs(0.5)),
+	        static_cast<unsigned long long>(latency.getPercentileUs(0.99)),
+	        static_cast<unsigned long long>(latency.getMaxUs()));
+}
+
+Uint64 Client::publishInjection(Outgoing&& frame) {
+	_injections[_injectionBack] = std::move(frame);
+
+	const Uint8 previous = _injectionMiddle.exchange(
+	    _injectionBack | FRESH_INJECTION);
+	_injectionBack = previous & ~FRESH_INJECTION;
+
+	Uint64 replacedId = 0;
+	if ((previous & FRESH_INJECTION) != 0) {
+		replacedId = _injections[_injectionBack].requestId;
+		_droppedFrames.fetch_add(1, std::memory_order_relaxed);
+	}
+	wake();
+	return replacedId;
+}
+
+// Never blocks: a full lane drops the message and counts it instead.
+void Client::pushMessage(Outgoing&& outgoing, const Lane lane) {
+	MessageQueue& queue = lane == Lane::BULK ? _bulkQueue : _controlQueue;
+	if (!queue.tryPush(std::move(outgoing))) {
+		_droppedMessages.fetch_add(1, std::memory_order_relaxed);
+	}
+	wake();
+}
+
+void Client::recycle(Outgoing& outgoing) {
+	if (!outgoing.shared) {
+		outgoing.owned.clear();
+		_spareBuffers.tryPush(std::move(outgoing.owned));
+	}
+	outgoing.shared.reset();
+}
+
+Client::Outgoing* Client::takeInjection() {
+	if ((_injectionMiddle.load() & FRESH_INJECTION) == 0) {
+		return nullptr;
+	}
+	_injectionFront = _injectionMiddle.exchange(_injectionFront)
+	                & ~FRESH_INJECTION;
+	return &_injections[_injectionFront];
+}
+
+// One wakeup covers everything queued until the socket thread drains it.
+void Client::wake() {
+	++_wakers;
+	mg_mgr* manager = _manager.load();
+	if (manager != nullptr && !_isWakeupPending.exchange(true)) {
+		if (!mg_wakeup(manager, _connectionId.load(), "", 0)) {
+			_isWakeupPending = false;
+		}
+	}
+	--_wakers;
+}
+
+void Client::writeMessage(mg_connection* connection, Outgoing& outgoing) {
+	const std::string& message = outgoing.shared ? *outgoing.shared
+	                                             : outgoing.owned;
+	mg_ws_send(connection, message.c_str(), message.size(), WEBSOCKET_OP_TEXT);
+	{
+		const std::lock_guard<std::mutex> lock(_statsMutex);
+		_queueLatency.record((SDL_GetTicksNS() - outgoing.queuedNs) / NS_PER_US);
+	}
+	recycle(outgoing);
+}
+
 void Client::threadFn() {
-	setStatus(Status::CONNECTING);
+	// A frame left over from the last connection belongs to a dead session.
+	if (Outgoing* stale = takeInjection()) {
+		recycle(*stale);
+	}
 	mg_mgr manager;
 	mg_mgr_init(&manager);
+	mg_wakeup_init(&manager);
 	auto           extraHeaders = std::format("Host: {}\r\n", _url);
 	mg_connection* connection   = mg_ws_connect(&manager,
                                            _url.c_str(),
                                            handleEvent,
                                            this,
                                            extraHeaders.c_str());
+	if (connection != nullptr) {
+		_connectionId    = connection->id;
+		_isWakeupPending = false;
+		_manager         = &manager;
+	}
+	else {
+		SDL_LogWarn(SDL_LOG_CATEGORY_APPLICATION,
+		            "Failed to connect to %s",
+		            _url.c_str());
+		_alive = false;
+	}
 	while (_alive) {
-		mg_mgr_poll(&manager, 64);
-		{
-			const std::lock_guard<std::mutex> lock(_sendMutex);
-			while (_alive && !_sendQueue.empty() && connection != nullptr) {
-				mg_ws_send(connection,
-				           _sendQueue.front().c_str(),
-				           _sendQueue.front().size(),
-				           WEBSOCKET_OP_TEXT);
-				_sendQueue.pop();
-			}
-		}
+		mg_mgr_poll(&manager, POLL_TIMEOUT_MS);
+	}
+	_manager = nullptr;
+	while (_wakers != 0) {
+		std::this_thread::yield();
 	}
 	mg_mgr_free(&manager);
+	logQueueLatency();
 	setStatus(Status::DISCONNECTED);
 }
 
@@ -115,19 +290,68 @@ const char* Client::getUrl() {
 	return _url.c_str();
 }
 
+std::size_t Client::getInstance() {
+	return _instance;
+}
+
 Status Client::getStatus() {
 	return _status;
 }
 
-void Client::sendMessage(std::string&& message) {
-	const std::lock_guard<std::mutex> lock(_sendMutex);
+void Client::clearQueueLatency() {
+	const std::lock_guard<std::mutex> lock(_statsMutex);
 
-	_sendQueue.push(std::move(message));
+	_queueLatency.clear();
+	_droppedFrames = 0;
+}
+
+Uint64 Client::getDroppedFrames() {
+	return _droppedFrames;
+}
+
+vts::LatencyHistogram Client::getQueueLatency() {
+	const std::lock_guard<std::mutex> lock(_statsMutex);
+
+	return _queueLatency;
+}
+
+bool Client::hasPendingInjection() {
+	return (_injectionMiddle.load() & FRESH_INJECTION) != 0;
+}
+
+std::string Client::acquireBuffer() {
+	std::string buffer;
+	_spareBuffers.tryPop(buffer);
+	return buffer;
+}
+
+Uint64 Client::sendInjection(const Uint64 requestId, std::string&& message) {
+	return publishInjection({.owned     = std::move(message),
+	                         .shared    = nullptr,
+	                         .queuedNs  = SDL_GetTicksNS(),
+	                         .requestId = requestId});
+}
+
+Uint64 Client::sendSharedInjection(
+    const Uint64                       requestId,
+    std::shared_ptr<const std::string> message) {
+	return publishInjection({.owned     = {},
+	                         .shared    = std::move(message),
+	                         .queuedNs  = SDL_GetTicksNS(),
+	                         .requestId = requestId});
+}
+
+void Client::sendMessage(std::string&& message, const Lane lane) {
+	pushMessage({.owned     = std::move(message),
+	             .shared    = nullptr,
+	             .queuedNs  = SDL_GetTicksNS(),
+	             .requestId = 0},
+	            lane);
 }
 
 void Client::setUrl(const char* url) {
 	_url = url;
-	SETTINGS.setWsUrl(url);
+	SETTINGS.setWsUrl(_instance, url);
 }
 
 void Client::start() {
@@ -135,12 +359,16 @@ void Client::start() {
 	if (_thread.joinable()) {
 		_thread.join();
 	}
+	// Set before the thread runs so a caller never sees the new connection as
+	// still disconnected.
+	setStatus(Status::CONNECTING);
 	_alive  = true;
 	_thread = std::thread(&Client::threadFn, this);
 }
 
 void Client::stop() {
 	_alive = false;
+	wake();
 	if (_thread.joinable()) {
 		if (std::this_thread::get_id() == _thread.get_id()) {
 			return;
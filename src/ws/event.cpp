@@ -10,4 +10,12 @@ static const size_t N_EVENTS = 2;
 void allocateEvents() {
 	SDL_RegisterEvents(N_EVENTS);
 }
+
+std::size_t getInstance(const SDL_UserEvent& event) {
+	return event.windowID;
+}
+
+void setInstance(SDL_UserEvent& event, const std::size_t instance) {
+	event.windowID = static_cast<SDL_WindowID>(instance);
+}
 }  // namespace ws